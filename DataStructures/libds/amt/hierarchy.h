@@ -3,6 +3,8 @@
 #include <libds/amt/abstract_memory_type.h>
 #include <libds/amt/explicit_sequence.h>
 #include <functional>
+#include <vector>
+#include <utility>
 
 namespace ds::amt {
 
@@ -125,6 +127,89 @@ namespace ds::amt {
 
 		//----------
 
+	protected:
+		// iterator do hlbky bez alokacie pri zostupe: ramce su v poli pevnej velkosti priamo v iteratore,
+		// az hlbsie urovne pokracuju vo vektore, ktoreho kapacita sa pri dalsom zostupe znova pouzije
+		class InlineDepthFirstIterator
+		{
+		protected:
+			struct Frame
+			{
+				BlockType* node_;
+				size_t nextSonOrder_;
+				size_t visitedSonCount_;
+			};
+
+			static const size_t INLINE_CAPACITY = 16;
+
+		public:
+			InlineDepthFirstIterator(Hierarchy<BlockType>* hierarchy);
+			bool operator==(const InlineDepthFirstIterator& other) const;
+			bool operator!=(const InlineDepthFirstIterator& other) const;
+			DataType& operator*();
+
+		protected:
+			Frame& frame(size_t index);
+			const Frame& frame(size_t index) const;
+			void pushFrame(BlockType* node);
+			void popFrame();
+			BlockType* tryFindNextSon();							// dalsi nenulovy syn vrchola na vrchu zasobnika alebo nullptr
+
+			Hierarchy<BlockType>* hierarchy_;
+			Frame inlineFrames_[INLINE_CAPACITY];
+			std::vector<Frame> overflowFrames_;
+			size_t depth_;
+		};
+
+	public:
+		// iterator v priamom poradi bez alokacie pri zostupe
+		class InlinePreOrderHierarchyIterator :
+			public InlineDepthFirstIterator
+		{
+		public:
+			InlinePreOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node);
+			InlinePreOrderHierarchyIterator& operator++();
+		};
+
+		// iterator v spatnom poradi bez alokacie pri zostupe
+		class InlinePostOrderHierarchyIterator :
+			public InlineDepthFirstIterator
+		{
+		public:
+			InlinePostOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node);
+			InlinePostOrderHierarchyIterator& operator++();
+
+		protected:
+			void descend();										// zostup po prvych synoch az po list
+		};
+
+		//----------
+
+		// iterator do sirky (po urovniach): vrcholy cakajuce na spracovanie su v kruhovom buffri,
+		// pri naplneni sa kapacita zdvojnasobi => pocas prechodu sa alokuje len O(log n) krat
+		class LevelOrderHierarchyIterator
+		{
+		public:
+			LevelOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node);
+			bool operator==(const LevelOrderHierarchyIterator& other) const;
+			bool operator!=(const LevelOrderHierarchyIterator& other) const;
+			DataType& operator*();
+			LevelOrderHierarchyIterator& operator++();
+
+		protected:
+			static const size_t INIT_CAPACITY = 16;
+
+			void push(BlockType* node);							// vlozi na koniec radu
+			BlockType* pop();									// vyberie zo zaciatku radu
+
+			Hierarchy<BlockType>* hierarchy_;
+			std::vector<BlockType*> queue_;						// kapacita je mocnina 2 => index sa pretaca maskou
+			size_t removalIndex_;
+			size_t size_;
+		};
+
+		//----------
+
 		using IteratorType = PreOrderHierarchyIterator;
 
 		IteratorType begin();
@@ -133,6 +218,12 @@ namespace ds::amt {
 		PreOrderHierarchyIterator endPre();
 	    PostOrderHierarchyIterator beginPost();
         PostOrderHierarchyIterator endPost();
+		InlinePreOrderHierarchyIterator beginInlinePre();
+		InlinePreOrderHierarchyIterator endInlinePre();
+		InlinePostOrderHierarchyIterator beginInlinePost();
+		InlinePostOrderHierarchyIterator endInlinePost();
+		LevelOrderHierarchyIterator beginLevel();
+		LevelOrderHierarchyIterator endLevel();
     };
 
 	//----------
@@ -561,6 +652,220 @@ namespace ds::amt {
 		return *this;
 	}
 
+	template<typename BlockType>
+	Hierarchy<BlockType>::InlineDepthFirstIterator::InlineDepthFirstIterator(Hierarchy<BlockType>* hierarchy) :
+		hierarchy_(hierarchy),
+		inlineFrames_(),
+		overflowFrames_(),
+		depth_(0)
+	{
+	}
+
+	template<typename BlockType>
+	bool Hierarchy<BlockType>::InlineDepthFirstIterator::operator==(const InlineDepthFirstIterator& other) const
+	{
+		// rovnaky vrchol v rovnakej hlbke, alebo oba na konci
+		return hierarchy_ == other.hierarchy_ && depth_ == other.depth_ && (depth_ == 0 || frame(depth_ - 1).node_ == other.frame(depth_ - 1).node_);
+	}
+
+	template<typename BlockType>
+	bool Hierarchy<BlockType>::InlineDepthFirstIterator::operator!=(const InlineDepthFirstIterator& other) const
+	{
+		return !(*this == other);
+	}
+
+	template<typename BlockType>
+	auto Hierarchy<BlockType>::InlineDepthFirstIterator::operator*() -> DataType&
+	{
+		return frame(depth_ - 1).node_->data_;
+	}
+
+	template<typename BlockType>
+	auto Hierarchy<BlockType>::InlineDepthFirstIterator::frame(size_t index) -> Frame&
+	{
+		return index < INLINE_CAPACITY ? inlineFrames_[index] : overflowFrames_[index - INLINE_CAPACITY];
+	}
+
+	template<typename BlockType>
+	auto Hierarchy<BlockType>::InlineDepthFirstIterator::frame(size_t index) const -> const Frame&
+	{
+		return index < INLINE_CAPACITY ? inlineFrames_[index] : overflowFrames_[index - INLINE_CAPACITY];
+	}
+
+	template<typename BlockType>
+	void Hierarchy<BlockType>::InlineDepthFirstIterator::pushFrame(BlockType* node)
+	{
+		// vektor sa pri vynoreni nezmensuje => uz raz dosiahnuta hlbka sa dalej nealokuje
+		if (depth_ >= INLINE_CAPACITY && depth_ - INLINE_CAPACITY == overflowFrames_.size())
+		{
+			overflowFrames_.push_back(Frame());
+		}
+		frame(depth_) = Frame{ node, 0, 0 };
+		++depth_;
+	}
+
+	template<typename BlockType>
+	void Hierarchy<BlockType>::InlineDepthFirstIterator::popFrame()
+	{
+		--depth_;
+	}
+
+	template<typename BlockType>
+	BlockType* Hierarchy<BlockType>::InlineDepthFirstIterator::tryFindNextSon()
+	{
+		// nulovi synovia (k-cestna hierarchia) sa preskocia, do stupna sa nepocitaju
+		Frame& current = frame(depth_ - 1);
+		size_t currentDegree = hierarchy_->degree(*current.node_);
+		while (current.visitedSonCount_ < currentDegree)
+		{
+			BlockType* son = hierarchy_->accessSon(*current.node_, current.nextSonOrder_++);
+			if (son != nullptr)
+			{
+				++current.visitedSonCount_;
+				return son;
+			}
+		}
+		return nullptr;
+	}
+
+	template<typename BlockType>
+	Hierarchy<BlockType>::InlinePreOrderHierarchyIterator::InlinePreOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node) :
+		InlineDepthFirstIterator(hierarchy)
+	{
+		if (node != nullptr)
+		{
+			this->pushFrame(node);
+		}
+	}
+
+	template<typename BlockType>
+	typename Hierarchy<BlockType>::InlinePreOrderHierarchyIterator& Hierarchy<BlockType>::InlinePreOrderHierarchyIterator::operator++()
+	{
+		// dalsi je najblizsi nenavstiveny syn vrchola na vrchu alebo niektoreho z jeho predkov
+		BlockType* son = this->tryFindNextSon();
+		while (son == nullptr)
+		{
+			this->popFrame();
+			if (this->depth_ == 0)
+			{
+				return *this;
+			}
+			son = this->tryFindNextSon();
+		}
+		this->pushFrame(son);
+		return *this;
+	}
+
+	template<typename BlockType>
+	Hierarchy<BlockType>::InlinePostOrderHierarchyIterator::InlinePostOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node) :
+		InlineDepthFirstIterator(hierarchy)
+	{
+		if (node != nullptr)
+		{
+			this->pushFrame(node);
+			this->descend();
+		}
+	}
+
+	template<typename BlockType>
+	typename Hierarchy<BlockType>::InlinePostOrderHierarchyIterator& Hierarchy<BlockType>::InlinePostOrderHierarchyIterator::operator++()
+	{
+		// vrchol na vrchu je spracovany; dalsi je najlavejsi list podstromu dalsieho syna otca, inak otec
+		this->popFrame();
+		if (this->depth_ > 0)
+		{
+			this->descend();
+		}
+		return *this;
+	}
+
+	template<typename BlockType>
+	void Hierarchy<BlockType>::InlinePostOrderHierarchyIterator::descend()
+	{
+		for (BlockType* son = this->tryFindNextSon(); son != nullptr; son = this->tryFindNextSon())
+		{
+			this->pushFrame(son);
+		}
+	}
+
+	template<typename BlockType>
+	Hierarchy<BlockType>::LevelOrderHierarchyIterator::LevelOrderHierarchyIterator(Hierarchy<BlockType>* hierarchy, BlockType* node) :
+		hierarchy_(hierarchy),
+		queue_(),
+		removalIndex_(0),
+		size_(0)
+	{
+		if (node != nullptr)
+		{
+			this->push(node);
+		}
+	}
+
+	template<typename BlockType>
+	bool Hierarchy<BlockType>::LevelOrderHierarchyIterator::operator==(const LevelOrderHierarchyIterator& other) const
+	{
+		// rovnaky vrchol na zaciatku radu, alebo oba na konci
+		return hierarchy_ == other.hierarchy_ && size_ == other.size_ &&
+			(size_ == 0 || queue_[removalIndex_] == other.queue_[other.removalIndex_]);
+	}
+
+	template<typename BlockType>
+	bool Hierarchy<BlockType>::LevelOrderHierarchyIterator::operator!=(const LevelOrderHierarchyIterator& other) const
+	{
+		return !(*this == other);
+	}
+
+	template<typename BlockType>
+	auto Hierarchy<BlockType>::LevelOrderHierarchyIterator::operator*() -> DataType&
+	{
+		return queue_[removalIndex_]->data_;
+	}
+
+	template<typename BlockType>
+	typename Hierarchy<BlockType>::LevelOrderHierarchyIterator& Hierarchy<BlockType>::LevelOrderHierarchyIterator::operator++()
+	{
+		// spracovany vrchol odide z radu, jeho synovia sa zaradia na koniec (nulovi synovia sa preskocia)
+		BlockType* node = this->pop();
+		size_t nodeDegree = hierarchy_->degree(*node);
+		for (size_t sonOrder = 0, visitedSonCount = 0; visitedSonCount < nodeDegree; ++sonOrder)
+		{
+			BlockType* son = hierarchy_->accessSon(*node, sonOrder);
+			if (son != nullptr)
+			{
+				++visitedSonCount;
+				this->push(son);
+			}
+		}
+		return *this;
+	}
+
+	template<typename BlockType>
+	void Hierarchy<BlockType>::LevelOrderHierarchyIterator::push(BlockType* node)
+	{
+		if (size_ == queue_.size())
+		{
+			// plny buffer sa prelozi do dvojnasobneho tak, aby rad zacinal na indexe 0
+			std::vector<BlockType*> enlarged(queue_.empty() ? INIT_CAPACITY : queue_.size() * 2);
+			for (size_t i = 0; i < size_; ++i)
+			{
+				enlarged[i] = queue_[(removalIndex_ + i) & (queue_.size() - 1)];
+			}
+			queue_ = std::move(enlarged);
+			removalIndex_ = 0;
+		}
+		queue_[(removalIndex_ + size_) & (queue_.size() - 1)] = node;
+		++size_;
+	}
+
+	template<typename BlockType>
+	BlockType* Hierarchy<BlockType>::LevelOrderHierarchyIterator::pop()
+	{
+		BlockType* node = queue_[removalIndex_];
+		removalIndex_ = (removalIndex_ + 1) & (queue_.size() - 1);
+		--size_;
+		return node;
+	}
+
     template <typename BlockType>
     auto Hierarchy<BlockType>::begin() -> IteratorType
 	{
@@ -597,6 +902,42 @@ namespace ds::amt {
         return PostOrderHierarchyIterator(this, nullptr);
     }
 
+	template <typename BlockType>
+	typename Hierarchy<BlockType>::InlinePreOrderHierarchyIterator Hierarchy<BlockType>::beginInlinePre()
+	{
+		return InlinePreOrderHierarchyIterator(this, accessRoot());
+	}
+
+	template <typename BlockType>
+	typename Hierarchy<BlockType>::InlinePreOrderHierarchyIterator Hierarchy<BlockType>::endInlinePre()
+	{
+		return InlinePreOrderHierarchyIterator(this, nullptr);
+	}
+
+	template <typename BlockType>
+	typename Hierarchy<BlockType>::InlinePostOrderHierarchyIterator Hierarchy<BlockType>::beginInlinePost()
+	{
+		return InlinePostOrderHierarchyIterator(this, accessRoot());
+	}
+
+	template <typename BlockType>
+	typename Hierarchy<BlockType>::InlinePostOrderHierarchyIterator Hierarchy<BlockType>::endInlinePost()
+	{
+		return InlinePostOrderHierarchyIterator(this, nullptr);
+	}
+
+	template <typename BlockType>
+	typename Hierarchy<BlockType>::LevelOrderHierarchyIterator Hierarchy<BlockType>::beginLevel()
+	{
+		return LevelOrderHierarchyIterator(this, accessRoot());
+	}
+
+	template <typename BlockType>
+	typename Hierarchy<BlockType>::LevelOrderHierarchyIterator Hierarchy<BlockType>::endLevel()
+	{
+		return LevelOrderHierarchyIterator(this, nullptr);
+	}
+
     template <typename BlockType>
     BlockType* BinaryHierarchy<BlockType>::accessLeftSon(const BlockType& node) const
 	{
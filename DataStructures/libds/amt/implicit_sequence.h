@@ -67,6 +67,7 @@ namespace ds::amt {
 			ImplicitSequenceIterator& operator--();							// vzad PREfix
 			ImplicitSequenceIterator operator--(int);						// vzad POSTfix
 			void operator+(int count);										// posun sa o int
+			size_t operator-(const ImplicitSequenceIterator& other) const;	// pocet prvkov od other po tento iterator
 
 		private:
 			ImplicitSequence<DataType>* sequence_;
@@ -367,6 +368,12 @@ namespace ds::amt {
 	{
 		position_ = position_ + count;
 	}
+
+	template<typename DataType>
+	inline size_t ImplicitSequence<DataType>::ImplicitSequenceIterator::operator-(const ImplicitSequenceIterator& other) const
+	{
+		return position_ - other.position_;
+	}
 // koniec pridanych metod
 
 	// index prveho PLATNEHO prvku je 0
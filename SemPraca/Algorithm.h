@@ -1,23 +1,138 @@
 #pragma once
 #include <iterator>
 #include <functional>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include "WorkerPool.h"
+
+// predikat ako typ znamy pri preklade; spaja sa operatormi &&, || a !, vysledok je jeden predikat, ktory kompilator vlozi priamo do cyklu
+template <typename Callable>
+class Predicate
+{
+public:
+    explicit Predicate(Callable callable) : callable(std::move(callable)) {};
+    template <typename DataType>
+    bool operator()(DataType& data) const { return this->callable(data); };
+
+private:
+    Callable callable;
+};
+
+template <typename Callable>
+Predicate<Callable> predicate(Callable callable)
+{
+    return Predicate<Callable>(std::move(callable));
+}
+
+template <typename Left, typename Right>
+auto operator&&(const Predicate<Left>& left, const Predicate<Right>& right)
+{
+    return predicate([left, right](auto& data) { return left(data) && right(data); });
+}
+
+template <typename Left, typename Right>
+auto operator||(const Predicate<Left>& left, const Predicate<Right>& right)
+{
+    return predicate([left, right](auto& data) { return left(data) || right(data); });
+}
+
+template <typename Callable>
+auto operator!(const Predicate<Callable>& negated)
+{
+    return predicate([negated](auto& data) { return !negated(data); });
+}
 
 template <typename DataType, typename IteratorType>
 class Algorithm
 {
 public:
+    // predikat aj spracovanie su lubovolne volatelne objekty (lambda, Predicate, ...) => ziadne neprame volanie v cykle
+    // ak spracovanie vracia bool, false ukonci prechod
+    template <typename PredicateType, typename ProcessType>
+    void findAndProcess(IteratorType begin, IteratorType end, PredicateType predicate, ProcessType process);
+    // paralelna verzia pre iteratory s priamym pristupom (end - begin, posun o n); process sa vola v rovnakom poradi ako v sekvencnej verzii
+    template <typename PredicateType, typename ProcessType>
+    void findAndProcess(IteratorType begin, IteratorType end, PredicateType predicate, ProcessType process, WorkerPool& workers);
+
+    // povodne rozhranie cez std::function, len prepose volanie sablonovej verzii
     void findAndProcess(IteratorType begin, IteratorType end, typename std::function<bool(DataType&)> predicate, typename std::function<void(DataType&)> process);
+    void findAndProcess(IteratorType begin, IteratorType end, typename std::function<bool(DataType&)> predicate, typename std::function<void(DataType&)> process, WorkerPool& workers);
+
+private:
+    template <typename ProcessType>
+    static bool processItem(ProcessType& process, DataType& item);
 };
 
 template<typename DataType, typename IteratorType>
-void Algorithm<DataType, IteratorType>::findAndProcess(IteratorType begin, IteratorType end, typename std::function<bool(DataType&)> predicate, typename std::function<void(DataType&)> process)
+template<typename PredicateType, typename ProcessType>
+void Algorithm<DataType, IteratorType>::findAndProcess(IteratorType begin, IteratorType end, PredicateType predicate, ProcessType process)
 {
    while (begin != end)
     {
-        if (predicate(*begin))
+        if (predicate(*begin) && !processItem(process, *begin))
         {
-            process(*begin);
+            return;
         }
         ++begin;
     }
+}
+
+template<typename DataType, typename IteratorType>
+template<typename PredicateType, typename ProcessType>
+void Algorithm<DataType, IteratorType>::findAndProcess(IteratorType begin, IteratorType end, PredicateType predicate, ProcessType process, WorkerPool& workers)
+{
+    // kazdy usek si zhody odlozi do vlastneho buffra, process sa zavola az potom postupne po usekoch
+    std::vector<std::vector<DataType>> found(workers.getThreadCount());
+    workers.parallelFor(end - begin, found.size(), [&](size_t chunk, size_t first, size_t last)
+        {
+            IteratorType position{ begin };
+            position + static_cast<int>(first);
+            for (size_t i = first; i < last; ++i, ++position)
+            {
+                if (predicate(*position))
+                {
+                    found[chunk].push_back(*position);
+                }
+            }
+        });
+
+    for (auto& chunkFound : found)
+    {
+        for (auto& item : chunkFound)
+        {
+            if (!processItem(process, item))
+            {
+                return;
+            }
+        }
+    }
+}
+
+template<typename DataType, typename IteratorType>
+template<typename ProcessType>
+bool Algorithm<DataType, IteratorType>::processItem(ProcessType& process, DataType& item)
+{
+    if constexpr (std::is_same_v<std::invoke_result_t<ProcessType&, DataType&>, bool>)
+    {
+        return process(item);
+    }
+    else
+    {
+        process(item);
+        return true;
+    }
+}
+
+template<typename DataType, typename IteratorType>
+void Algorithm<DataType, IteratorType>::findAndProcess(IteratorType begin, IteratorType end, typename std::function<bool(DataType&)> predicate, typename std::function<void(DataType&)> process)
+{
+    // std::ref => vyberie sa sablonova verzia a std::function sa nekopiruje
+    this->findAndProcess(begin, end, std::ref(predicate), std::ref(process));
+}
+
+template<typename DataType, typename IteratorType>
+void Algorithm<DataType, IteratorType>::findAndProcess(IteratorType begin, IteratorType end, typename std::function<bool(DataType&)> predicate, typename std::function<void(DataType&)> process, WorkerPool& workers)
+{
+    this->findAndProcess(begin, end, std::ref(predicate), std::ref(process), workers);
 }
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <cstdint>
+#include "Unit.h"
+
+// BK strom nad oficialnymi nazvami jednotiek pre priblizne vyhladavanie (Levenshteinova vzdialenost po bajtoch)
+// syn je ulozeny pod vzdialenostou od otca; pri hladani do vzdialenosti d staci prejst synov so vzdialenostou v [x - d, x + d],
+// kde x je vzdialenost hladaneho nazvu od otca (trojuholnikova nerovnost) => vacsina nazvov sa vobec neporovnava
+class BKTree
+{
+public:
+    void insert(Unit* unit);
+    // najviac count jednotiek s nazvom vo vzdialenosti <= maxDistance, od najblizsej (rovnaka vzdialenost => v poradi vlozenia)
+    std::vector<Unit*> findClosest(std::string_view title, size_t maxDistance, size_t count) const;
+    size_t size() const { return this->nodes.size(); };
+
+    static size_t editDistance(std::string_view text1, std::string_view text2);
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Node
+    {
+        Unit* unit;
+        uint32_t distance;          // od otca
+        uint32_t firstSon;
+        uint32_t nextBrother;
+    };
+
+    std::vector<Node> nodes{};
+};
+
+void BKTree::insert(Unit* unit)
+{
+    uint32_t inserted = static_cast<uint32_t>(this->nodes.size());
+    this->nodes.push_back({ unit, 0, NONE, NONE });
+    if (inserted == 0)
+    {
+        return;
+    }
+
+    uint32_t node = 0;
+    while (true)
+    {
+        uint32_t distance = static_cast<uint32_t>(editDistance(unit->getOfficialTitle(), this->nodes[node].unit->getOfficialTitle()));
+        uint32_t son = this->nodes[node].firstSon;
+        while (son != NONE && this->nodes[son].distance != distance)
+        {
+            son = this->nodes[son].nextBrother;
+        }
+
+        if (son == NONE)
+        {
+            this->nodes[inserted].distance = distance;
+            this->nodes[inserted].nextBrother = this->nodes[node].firstSon;
+            this->nodes[node].firstSon = inserted;
+            return;
+        }
+        node = son;
+    }
+}
+
+std::vector<Unit*> BKTree::findClosest(std::string_view title, size_t maxDistance, size_t count) const
+{
+    std::vector<std::pair<size_t, uint32_t>> found{};          // (vzdialenost, vrchol)
+    if (this->nodes.empty())
+    {
+        return {};
+    }
+
+    std::vector<uint32_t> stack{ 0 };
+    while (!stack.empty())
+    {
+        uint32_t node = stack.back();
+        stack.pop_back();
+
+        size_t distance = editDistance(title, this->nodes[node].unit->getOfficialTitle());
+        if (distance <= maxDistance)
+        {
+            found.emplace_back(distance, node);
+        }
+
+        for (uint32_t son = this->nodes[node].firstSon; son != NONE; son = this->nodes[son].nextBrother)
+        {
+            size_t sonDistance = this->nodes[son].distance;
+            if (sonDistance + maxDistance >= distance && sonDistance <= distance + maxDistance)
+            {
+                stack.push_back(son);
+            }
+        }
+    }
+
+    count = (std::min)(count, found.size());
+    std::partial_sort(found.begin(), found.begin() + count, found.end());
+
+    std::vector<Unit*> closest{};
+    closest.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        closest.push_back(this->nodes[found[i].second].unit);
+    }
+    return closest;
+}
+
+size_t BKTree::editDistance(std::string_view text1, std::string_view text2)
+{
+    // dynamicke programovanie po riadkoch, pamata sa len predchadzajuci riadok
+    if (text1.size() < text2.size())
+    {
+        std::swap(text1, text2);
+    }
+
+    thread_local std::vector<size_t> row{};             // pri hladani sa vola pre kazdy navstiveny vrchol => bez alokacie
+    row.resize(text2.size() + 1);
+    for (size_t j = 0; j <= text2.size(); ++j)
+    {
+        row[j] = j;
+    }
+
+    for (size_t i = 1; i <= text1.size(); ++i)
+    {
+        size_t diagonal = row[0];
+        row[0] = i;
+        for (size_t j = 1; j <= text2.size(); ++j)
+        {
+            size_t above = row[j];
+            size_t substitution = diagonal + (text1[i - 1] == text2[j - 1] ? 0 : 1);
+            row[j] = (std::min)({ above + 1, row[j - 1] + 1, substitution });
+            diagonal = above;
+        }
+    }
+    return row[text2.size()];
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include <chrono>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include "IS.h"
+#include "HierarchySVK.h"
+#include "Tables.h"
+#include "Sort.h"
+#include "ResultCursor.h"
+
+// neinteraktivne spracovanie dotazov, jeden na riadok: uroven;typ;operacia;parameter[;cesta][;triedenie][;offset][;limit]
+//  uroven 1: typ 1-3, operacie z, o, Z, O, m, r, k ako v urovni 1 (parameter pri r je "a-b")
+//  uroven 2 (aj 4): typ sa nepouziva, operacie o, z, O, Z, t, m, r, k nad podstromom vrchola na ceste (napr. "7/3", prazdna = koren),
+//            cesta moze zacinat kodom alebo typom a poradovym cislom jednotky (napr. "@SK0101", "#3:15/2")
+//            s = nastavi pocet materskych skol jednotky vrchola na parameter (vo vsetkych indexoch), vysledkom je ta jednotka
+//  uroven 3: typ 1-3, operacia n = vyhladanie podla nazvu, N = to iste bez diakritiky a velkosti pismen,
+//            p = priblizne vyhladanie (parameter "nazov~d", bez ~d je d = 2),
+//            vysledky od najblizsieho, k najblizsich = limit
+//  triedenie: a = abecedne, s = podla poctu samohlasok, prazdne = bez triedenia
+//  offset, limit: vypise sa len strana vysledku, hladanie skonci po jej poslednej jednotke;
+//                 s triedenim sa strana vyberie az z celeho utriedeneho vysledku
+// prazdne riadky a riadky zacinajuce '#' sa preskocia; parameter nesmie obsahovat ';'
+// vysledky idu do buffra, ktory sa zapise po naplneni; ku kazdemu dotazu sa vypise cas, na konci priepustnost
+template <typename ISType>
+class BatchQueries
+{
+public:
+    BatchQueries(ImplicitSequences& IS, HierarchySVK<ISType>& hierarchy, Tables<Unit, ISType>& tables) : IS(IS), hierarchy(hierarchy), tables(tables) {};
+    void run(std::istream& input, std::ostream& output);
+
+private:
+    ResultCursor runQuery(const std::vector<std::string>& fields);
+
+private:
+    using duration_t = std::chrono::nanoseconds;
+    static constexpr std::streamoff FLUSH_SIZE = 1 << 16;
+    static constexpr size_t DEFAULT_DISTANCE = 2;
+
+    ImplicitSequences& IS;
+    HierarchySVK<ISType>& hierarchy;
+    Tables<Unit, ISType>& tables;
+    Sort<Unit*> sort{};
+};
+
+template <typename ISType>
+void BatchQueries<ISType>::run(std::istream& input, std::ostream& output)
+{
+    std::ostringstream buffer{};
+    std::string line{};
+    size_t lineNumber{ 0 };
+    size_t queryCount{ 0 };
+    size_t errorCount{ 0 };
+    duration_t queryTime{ 0 };
+    auto batchStart = std::chrono::high_resolution_clock::now();
+
+    while (std::getline(input, line))
+    {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+
+        std::vector<std::string> fields{};
+        std::istringstream lineStream{ line };
+        std::string field{};
+        while (std::getline(lineStream, field, ';'))
+        {
+            fields.push_back(field);
+        }
+
+        // jednotky sa zapisuju hned pri hladani, cas dotazu preto zahrna aj ich zapis do buffra; pocet a cas idu za ne
+        ++queryCount;
+        buffer << "# " << lineNumber << ": " << line << '\n';
+        auto timeStart = std::chrono::high_resolution_clock::now();
+        try
+        {
+            ResultCursor found{ this->runQuery(fields) };
+            size_t offset{ fields.size() > 6 && !fields[6].empty() ? std::stoull(fields[6]) : 0 };
+            bool limited{ fields.size() > 7 && !fields[7].empty() };
+            size_t limit{ limited ? std::stoull(fields[7]) : 0 };
+
+            auto print = [&buffer](Unit* unit) { buffer << '\t' << *unit << '\n'; };
+            size_t foundCount{ 0 };
+            if (fields.size() > 5 && !fields[5].empty())
+            {
+                // strana sa vybera z utriedeneho vysledku => triedia sa vsetky jednotky, nie len prva strana
+                ds::amt::ImplicitSequence<Unit*> sorted{};
+                found.materialize(sorted);
+                this->sort.sortBy(sorted, fields[5].front());
+                size_t pageEnd = limited ? (std::min)(sorted.size(), offset + limit) : sorted.size();
+                for (size_t i = offset; i < pageEnd; ++i)
+                {
+                    print(sorted.access(i)->data_);
+                    ++foundCount;
+                }
+            }
+            else
+            {
+                found.setOffset(offset);
+                if (limited)
+                {
+                    found.setLimit(limit);
+                }
+                foundCount = found.forEach(print);
+            }
+
+            duration_t latency = std::chrono::duration_cast<duration_t>(std::chrono::high_resolution_clock::now() - timeStart);
+            queryTime += latency;
+            buffer << "#   " << foundCount << " jednotiek | " << latency.count() << " ns\n";
+        }
+        catch (std::exception& ex)
+        {
+            queryTime += std::chrono::duration_cast<duration_t>(std::chrono::high_resolution_clock::now() - timeStart);
+            ++errorCount;
+            buffer << "#   chyba: " << ex.what() << '\n';
+        }
+
+        if (buffer.tellp() >= FLUSH_SIZE)
+        {
+            output << buffer.str();
+            buffer.str("");
+        }
+    }
+
+    duration_t batchTime = std::chrono::duration_cast<duration_t>(std::chrono::high_resolution_clock::now() - batchStart);
+    buffer << "# dotazov: " << queryCount << ", chb: " << errorCount
+        << ", as dotazov: " << queryTime.count() << " ns, celkov as: " << batchTime.count() << " ns";
+    if (queryTime.count() > 0)
+    {
+        buffer << ", priepustnos: " << queryCount * 1000000000 / queryTime.count() << " dotazov/s";
+    }
+    buffer << '\n';
+    output << buffer.str();
+    output.flush();
+}
+
+template <typename ISType>
+ResultCursor BatchQueries<ISType>::runQuery(const std::vector<std::string>& fields)
+{
+    if (fields.size() < 3 || fields[2].size() != 1)
+    {
+        throw std::invalid_argument("Nesprvny formt dotazu!");
+    }
+
+    size_t level = std::stoull(fields[0]);
+    char operation = fields[2].front();
+    std::string parameter{ fields.size() > 3 ? fields[3] : std::string{} };
+    switch (level)
+    {
+    case 1:
+        return this->IS.findUnits(std::stoull(fields[1]), operation, parameter);
+    case 2:
+    case 4:
+    {
+        size_t node = this->hierarchy.accessNode(fields.size() > 4 ? fields[4] : std::string{});
+        if (operation == 's')
+        {
+            // zmena sa vykona hned, nie az pri prechode kurzorom => nasledujuce dotazy ju uz vidia
+            this->hierarchy.setKindergartenNum(node, std::stoull(parameter));
+            return ResultCursor([unit = this->hierarchy.accessUnit(node)](const ResultCursor::Yield& yield) { yield(unit); });
+        }
+        return this->hierarchy.findUnits(node, operation, parameter);
+    }
+    case 3:
+        if (operation == 'p')
+        {
+            size_t separator = parameter.rfind('~');
+            if (separator == std::string::npos)
+            {
+                return this->tables.findSimilar(std::stoull(fields[1]), parameter, DEFAULT_DISTANCE);
+            }
+            return this->tables.findSimilar(std::stoull(fields[1]), parameter.substr(0, separator), std::stoull(parameter.substr(separator + 1)));
+        }
+        if (operation != 'n' && operation != 'N')
+        {
+            throw std::invalid_argument("Neznma opercia!");
+        }
+        return this->tables.findUnits(std::stoull(fields[1]), parameter, operation == 'N' ? FOLDED_MATCH : EXACT_MATCH);
+    default:
+        throw std::invalid_argument("Neznma rove!");
+    }
+}
@@ -0,0 +1,280 @@
+#pragma once
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include "IS.h"
+#include "Algorithm.h"
+#include "UnitColumns.h"
+#include "KindergartenIndex.h"
+#include "TrigramIndex.h"
+#include "PrefixIndex.h"
+#include "BKTree.h"
+#include "HierarchySVK.h"
+#include "FlatHierarchy.h"
+#include "WorkerPool.h"
+
+// meranie operacii nad celym datasetom (vsetky kraje, okresy a obce), spusta sa prepinacom --benchmark
+// kazda operacia sa opakuje REPLICATION_COUNT krat, vypise sa median a minimum jedneho opakovania
+class Benchmark
+{
+public:
+    Benchmark(ImplicitSequences& IS);
+    void run();
+
+private:
+    void measure(const std::string& name, const std::function<size_t()>& operation);
+    // operacia z PASS_COUNT prechodov, vysledkom je pocet najdenych v poslednom
+    template <typename PassType>
+    static std::function<size_t()> repeated(size_t& found, PassType pass);
+    void benchmarkPipeline();
+    void benchmarkKindergartenIndex();
+    void benchmarkSimilarTitles();
+    void benchmarkFoldedTitles();
+    void benchmarkHierarchyIterators();
+
+private:
+    using duration_t = std::chrono::microseconds;
+    static constexpr size_t REPLICATION_COUNT = 50;
+    static constexpr size_t PASS_COUNT = 100;           // prechodov datasetom v jednom opakovani
+
+    ImplicitSequences& IS;
+    UnitColumns columns{};
+};
+
+Benchmark::Benchmark(ImplicitSequences& IS) : IS(IS)
+{
+    for (auto* units : { &IS.getRegions(), &IS.getDistricts(), &IS.getMunicipalities() })
+    {
+        for (Unit* unit : *units)
+        {
+            this->columns.insertLast(unit);
+        }
+    }
+}
+
+void Benchmark::run()
+{
+    std::cout << "Poet jednotiek: " << this->columns.size() << ", opakovan: " << REPLICATION_COUNT << ", prechodov v opakovan: " << PASS_COUNT << "\n\n";
+    std::cout << std::left << std::setw(48) << "opercia" << std::right << std::setw(14) << "medin [us]" << std::setw(14) << "minimum [us]" << std::setw(12) << "njden" << '\n';
+    this->benchmarkPipeline();
+    this->benchmarkKindergartenIndex();
+    this->benchmarkSimilarTitles();
+    this->benchmarkFoldedTitles();
+    this->benchmarkHierarchyIterators();
+}
+
+void Benchmark::measure(const std::string& name, const std::function<size_t()>& operation)
+{
+    std::vector<duration_t> samples{};
+    size_t found{ 0 };
+    for (size_t replication = 0; replication < REPLICATION_COUNT; ++replication)
+    {
+        auto timeStart = std::chrono::high_resolution_clock::now();
+        found = operation();
+        auto timeEnd = std::chrono::high_resolution_clock::now();
+        samples.push_back(std::chrono::duration_cast<duration_t>(timeEnd - timeStart));
+    }
+
+    std::sort(samples.begin(), samples.end());
+    std::cout << std::left << std::setw(48) << name << std::right
+        << std::setw(14) << samples[samples.size() / 2].count()
+        << std::setw(14) << samples.front().count()
+        << std::setw(12) << found << '\n';
+}
+
+template <typename PassType>
+std::function<size_t()> Benchmark::repeated(size_t& found, PassType pass)
+{
+    return [&found, pass]() -> size_t
+        {
+            for (size_t i = 0; i < PASS_COUNT; ++i)
+            {
+                found = 0;
+                pass();
+            }
+            return found;
+        };
+}
+
+void Benchmark::benchmarkPipeline()
+{
+    // rovnake filtre raz cez std::function, raz ako sablonove predikaty; pocet najdenych sa musi zhodovat
+    Algorithm<UnitRow, UnitColumns::RowIterator> algorithm;
+    size_t kindergartenNum{ 2 };
+    size_t type{ 3 };
+    std::string prefix{ "S" };
+    size_t found{ 0 };
+
+    std::function<bool(UnitRow&)> atLeastNFunction = [&](UnitRow& row) { return row.getKindergartenNum() >= kindergartenNum; };
+    std::function<bool(UnitRow&)> hasTypeFunction = [&](UnitRow& row) { return row.hasType(type); };
+    std::function<bool(UnitRow&)> startsWithFunction = [&](UnitRow& row) { return row.startsWithStr(prefix); };
+    std::function<bool(UnitRow&)> combinedFunction = [&](UnitRow& row) { return (atLeastNFunction(row) && hasTypeFunction(row)) || !startsWithFunction(row); };
+    std::function<void(UnitRow&)> countFunction = [&](UnitRow&) { ++found; };
+
+    auto atLeastN = predicate([&](UnitRow& row) { return row.getKindergartenNum() >= kindergartenNum; });
+    auto hasType = predicate([&](UnitRow& row) { return row.hasType(type); });
+    auto startsWith = predicate([&](UnitRow& row) { return row.startsWithStr(prefix); });
+    auto combined = (atLeastN && hasType) || !startsWith;
+    auto count = [&](UnitRow&) { ++found; };
+
+    this->measure("m, std::function", repeated(found, [&]() { algorithm.findAndProcess(this->columns.begin(), this->columns.end(), atLeastNFunction, countFunction); }));
+    this->measure("m, ablna", repeated(found, [&]() { algorithm.findAndProcess(this->columns.begin(), this->columns.end(), atLeastN, count); }));
+    this->measure("(m && t) || !z, std::function", repeated(found, [&]() { algorithm.findAndProcess(this->columns.begin(), this->columns.end(), combinedFunction, countFunction); }));
+    this->measure("(m && t) || !z, kombintory", repeated(found, [&]() { algorithm.findAndProcess(this->columns.begin(), this->columns.end(), combined, count); }));
+    this->measure("(m && t) || !z, std::function paralelne", repeated(found, [&]() { algorithm.findAndProcess(this->columns.begin(), this->columns.end(), combinedFunction, countFunction, this->IS.getWorkers()); }));
+    this->measure("(m && t) || !z, kombintory paralelne", repeated(found, [&]() { algorithm.findAndProcess(this->columns.begin(), this->columns.end(), combined, count, this->IS.getWorkers()); }));
+}
+
+void Benchmark::benchmarkKindergartenIndex()
+{
+    // prahovy dotaz prehliadkou vsetkych jednotiek a cez index (binarne vyhladavanie + usek)
+    Algorithm<UnitRow, UnitColumns::RowIterator> algorithm;
+    KindergartenIndex kindergartens{};
+    kindergartens.build(this->columns);
+    size_t kindergartenNum{ 10 };
+    size_t found{ 0 };
+    auto count = [&](UnitRow&) { ++found; return true; };
+
+    this->measure("m >= 10, prehliadka", repeated(found, [&]() { algorithm.findAndProcess(this->columns.begin(), this->columns.end(), [&](UnitRow& row) { return row.getKindergartenNum() >= kindergartenNum; }, count); }));
+    this->measure("m >= 10, index", repeated(found, [&]() { kindergartens.findAtLeast(kindergartenNum, 0, this->columns.size(), count); }));
+    this->measure("top 10, index", repeated(found, [&]() { kindergartens.findTop(10, 0, this->columns.size(), count); }));
+}
+
+void Benchmark::benchmarkFoldedTitles()
+{
+    // hladanie bez diakritiky porovnava zlozene nazvy z nacitania => ma stat rovnako ako presne hladanie
+    TrigramIndex trigrams{};
+    trigrams.build(this->columns);
+    PrefixIndex prefixes{};
+    prefixes.build(this->columns);
+    size_t found{ 0 };
+    auto count = [&found](UnitRow&) { ++found; return true; };
+
+    this->measure("obsahuje \"ov\", presne", repeated(found, [&]() { trigrams.findContaining("ov", EXACT_MATCH, 0, this->columns.size(), count); }));
+    this->measure("obsahuje \"OVA\", bez diakritiky", repeated(found, [&]() { trigrams.findContaining("OVA", FOLDED_MATCH, 0, this->columns.size(), count); }));
+    this->measure("zana \"Nov\", presne", repeated(found, [&]() { prefixes.findStartingWith("Nov", EXACT_MATCH, 0, this->columns.size(), count); }));
+    this->measure("zana \"nova\", bez diakritiky", repeated(found, [&]() { prefixes.findStartingWith("nova", FOLDED_MATCH, 0, this->columns.size(), count); }));
+}
+
+void Benchmark::benchmarkSimilarTitles()
+{
+    // 5 najblizsich nazvov obci do vzdialenosti 2 cez BK strom a porovnanim so vsetkymi nazvami
+    BKTree similar{};
+    for (Unit* unit : this->IS.getMunicipalities())
+    {
+        similar.insert(unit);
+    }
+    std::string title{ "Zilina" };
+    size_t found{ 0 };
+
+    this->measure("podobn nzvy d <= 2, vetky nzvy", repeated(found, [&]()
+        {
+            std::vector<std::pair<size_t, Unit*>> closest{};
+            for (Unit* unit : this->IS.getMunicipalities())
+            {
+                size_t distance = BKTree::editDistance(title, unit->getOfficialTitle());
+                if (distance <= 2)
+                {
+                    closest.emplace_back(distance, unit);
+                }
+            }
+            found = (std::min)(closest.size(), static_cast<size_t>(5));
+        }));
+    this->measure("podobn nzvy d <= 2, BK strom", repeated(found, [&]() { found = similar.findClosest(title, 2, 5).size(); }));
+}
+
+void Benchmark::benchmarkHierarchyIterators()
+{
+    // prechod celou hierarchiou kraj - okres - obec: iteratory s ramcami na halde a s ramcami v iteratore
+    ds::amt::MultiWayExplicitHierarchy<Unit*> hierarchy{};
+    hierarchy.emplaceRoot().data_ = nullptr;
+    HierarchySVK<ds::amt::ImplicitSequence<Unit*>>::loadUnits(hierarchy, this->IS.getRegions(), this->IS.getDistricts(), this->IS.getMunicipalities());
+    size_t found{ 0 };
+
+    this->measure("pre-order, rmce na halde", repeated(found, [&]()
+        {
+            for (auto it = hierarchy.beginPre(), end = hierarchy.endPre(); it != end; ++it)
+            {
+                found += *it != nullptr ? 1 : 0;
+            }
+        }));
+    this->measure("pre-order, rmce v itertore", repeated(found, [&]()
+        {
+            for (auto it = hierarchy.beginInlinePre(), end = hierarchy.endInlinePre(); it != end; ++it)
+            {
+                found += *it != nullptr ? 1 : 0;
+            }
+        }));
+    this->measure("post-order, rmce na halde", repeated(found, [&]()
+        {
+            for (auto it = hierarchy.beginPost(), end = hierarchy.endPost(); it != end; ++it)
+            {
+                found += *it != nullptr ? 1 : 0;
+            }
+        }));
+    this->measure("post-order, rmce v itertore", repeated(found, [&]()
+        {
+            for (auto it = hierarchy.beginInlinePost(), end = hierarchy.endInlinePost(); it != end; ++it)
+            {
+                found += *it != nullptr ? 1 : 0;
+            }
+        }));
+
+    this->measure("level-order, kruhov buffer", repeated(found, [&]()
+        {
+            for (auto it = hierarchy.beginLevel(), end = hierarchy.endLevel(); it != end; ++it)
+            {
+                found += *it != nullptr ? 1 : 0;
+            }
+        }));
+
+    // paralelny prechod zmrazenej kopie po ulohach s ~4096 vrcholmi oproti sekvencnemu, na celom Slovensku a na 32 kopiach pod spolocnym korenom
+    // => podla tohto sa nastavuje hranica, od ktorej ide dotaz na typ v urovni 2 paralelne
+    ds::amt::MultiWayExplicitHierarchy<Unit*> scaled{};
+    scaled.emplaceRoot().data_ = nullptr;
+    std::function<void(const ds::amt::MWEHBlock<Unit*>&, ds::amt::MWEHBlock<Unit*>&)> copySubtree =
+        [&](const ds::amt::MWEHBlock<Unit*>& source, ds::amt::MWEHBlock<Unit*>& target)
+        {
+            for (size_t son = 0; son < hierarchy.degree(source); ++son)
+            {
+                ds::amt::MWEHBlock<Unit*>& copy = scaled.emplaceSon(target, son);
+                copy.data_ = hierarchy.accessSon(source, son)->data_;
+                copySubtree(*hierarchy.accessSon(source, son), copy);
+            }
+        };
+    for (size_t copy = 0; copy < 32; ++copy)
+    {
+        ds::amt::MWEHBlock<Unit*>& copyRoot = scaled.emplaceSon(*scaled.accessRoot(), copy);
+        copyRoot.data_ = nullptr;
+        copySubtree(*hierarchy.accessRoot(), copyRoot);
+    }
+
+    FlatHierarchy<Unit*> flats[2]{};
+    flats[0].build(hierarchy);
+    flats[1].build(scaled);
+    const char* names[2][2] = { { "obce podstromu, sekvenne", "obce podstromu, paralelne" }, { "obce podstromu x32, sekvenne", "obce podstromu x32, paralelne" } };
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const FlatHierarchy<Unit*>& flat = flats[i];
+        auto visitMunicipality = [&flat](size_t node, size_t& municipalityCount) { municipalityCount += flat.access(node) != nullptr && flat.access(node)->getType() == 3 ? 1 : 0; };
+        this->measure(names[i][0], repeated(found, [&]()
+            {
+                for (size_t node = 0; node < flat.size(); ++node)
+                {
+                    visitMunicipality(node, found);
+                }
+            }));
+        this->measure(names[i][1], repeated(found, [&]()
+            {
+                found += flat.traverseParallel<size_t>(flat.accessRoot(), 1 << 12, this->IS.getWorkers(), visitMunicipality,
+                    [](size_t& target, size_t& source) { target += source; });
+            }));
+    }
+
+    scaled.clear();
+    hierarchy.clear();          // jednotky patria UnitStore
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+// klasifikacia znakov kodovania CP1250 (v nom su CSV subory aj zdrojove subory) cez tabulku s 256 polozkami
+struct Cp1250
+{
+    static constexpr uint8_t VOWEL = 1 << 0;
+
+    static constexpr std::array<uint8_t, 256> buildClasses();
+    // znak bez diakritiky a malym pismenom, napr. '' -> 'z'; kazdy znak sa zobrazi na jeden znak => zlozeny retazec ma rovnaku dlzku
+    static constexpr std::array<char, 256> buildFolds();
+    static bool isVowel(char letter);
+    static char fold(char letter);
+    static std::string fold(std::string_view text);
+};
+
+constexpr std::array<uint8_t, 256> Cp1250::buildClasses()
+{
+    std::array<uint8_t, 256> classes{};
+    for (char vowel : std::string_view{ "aeiouyAEIOUY" })
+    {
+        classes[static_cast<unsigned char>(vowel)] |= VOWEL;
+    }
+    return classes;
+}
+
+constexpr std::array<char, 256> Cp1250::buildFolds()
+{
+    constexpr std::string_view accented{ "㥹ż徣" };
+    constexpr std::string_view plain{ "aaaaaaaaaaccccccddeeeeeeeeiiiillllllnnnnoooooooorrrrssssssttttuuuuuuuuyyzzzzzz" };
+    static_assert(accented.size() == plain.size(), "Kad znak s diakritikou mus ma znak bez nej.");
+
+    std::array<char, 256> folds{};
+    for (size_t letter = 0; letter < folds.size(); ++letter)
+    {
+        folds[letter] = letter >= 'A' && letter <= 'Z' ? static_cast<char>(letter - 'A' + 'a') : static_cast<char>(letter);
+    }
+    for (size_t i = 0; i < accented.size(); ++i)
+    {
+        folds[static_cast<unsigned char>(accented[i])] = plain[i];
+    }
+    return folds;
+}
+
+// tabulky sa vypocitaju uz pri preklade
+constexpr std::array<uint8_t, 256> CP1250_CLASSES = Cp1250::buildClasses();
+constexpr std::array<char, 256> CP1250_FOLDS = Cp1250::buildFolds();
+
+bool Cp1250::isVowel(char letter)
+{
+    return (CP1250_CLASSES[static_cast<unsigned char>(letter)] & VOWEL) != 0;
+}
+
+char Cp1250::fold(char letter)
+{
+    return CP1250_FOLDS[static_cast<unsigned char>(letter)];
+}
+
+std::string Cp1250::fold(std::string_view text)
+{
+    std::string folded(text.size(), '\0');
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        folded[i] = fold(text[i]);
+    }
+    return folded;
+}
@@ -1,64 +1,329 @@
 #pragma once
 #include <iostream>
-#include <fstream>
-#include <sstream>
-#include <vector>
+#include <string>
+#include <string_view>
+#include <charconv>
 #include <functional>
+#include <vector>
+#include <unordered_map>
+#include "MappedFile.h"
+#include "WorkerPool.h"
+#include "UnitStore.h"
 
 template <typename DataType>
 class DataIO
 {
 public:
+    DataIO(UnitStore& store) : store(store) {};
+
     void dataInput(std::string unitName, typename std::function<void(DataType*)> insert);
+    void setTitleQualifier(std::function<std::string(std::string_view)> qualifier) { this->titleQualifier = std::move(qualifier); };
+    template <typename SequenceType>
+    void dataInputParallel(std::string unitName, SequenceType& sequence, WorkerPool& workers);
+
+private:
+    static constexpr size_t MAX_FIELDS = 6;
+    static constexpr size_t TITLE_FIELD = 2;
+    static constexpr size_t NO_MATCH = static_cast<size_t>(-1);
+
+    std::vector<size_t> joinExtra(const std::string& unitType, const std::vector<std::string_view>& lines, const std::vector<std::string_view>& linesExtra);
+    void joinByKey(const std::vector<std::string_view>& mainKeys, const std::vector<std::string_view>& extraKeys, std::vector<size_t>& matches, std::vector<bool>& extraMatched);
+    DataType* parseUnit(std::string_view line, std::string_view lineExtra, UnitArena& arena);
+    std::vector<std::string_view> splitLines(std::string_view content, WorkerPool* workers);
+    bool nextLine(std::string_view& content, std::string_view& line);
+    size_t splitLine(std::string_view line, std::string_view* fields);
+    size_t parseNumber(std::string_view field);
+
+private:
+    UnitStore& store;                                               // vlastnik nacitanych jednotiek
+    size_t extraOffset{ 0 };                                        // 1, ak _extra subor zacina vlastnym stlpcom s klucom
+    std::function<std::string(std::string_view)> titleQualifier{};  // podla kodu jednotky vrati priponu, ktorou sa rozlisi rovnaky nazov
 };
 
 template <typename DataType>
 void DataIO<DataType>::dataInput(std::string unitType, typename std::function<void(DataType*)> insert)
 {
-    std::ifstream input{ unitType + ".csv" };
-    std::string line{};
+    MappedFile input{ unitType + ".csv" };
+    MappedFile inputExtra{ unitType + "_extra.csv" };
 
-    std::ifstream inputExtra{ unitType + "_extra.csv" };
-    std::string lineExtra{};
+    std::vector<std::string_view> lines{ this->splitLines(input.getContent(), nullptr) };
+    std::vector<std::string_view> linesExtra{ this->splitLines(inputExtra.getContent(), nullptr) };
+    std::vector<size_t> matches{ this->joinExtra(unitType, lines, linesExtra) };
 
-    if (!input || !inputExtra)
+    UnitArena& arena{ this->store.getArena() };
+    for (size_t row = 1; row < lines.size(); ++row)     // pri nacitavani sa 1. riadok (nadpisy) vynecha
     {
-        throw std::runtime_error("Chyba pri tan zo sboru!");
+        insert(this->parseUnit(lines[row], matches[row] != NO_MATCH ? linesExtra[matches[row]] : std::string_view{}, arena));
     }
+}
 
-    std::getline(input, line);                      // pri nacitavani sa 1. riadok (nadpisy) vynecha
-    std::getline(inputExtra, lineExtra);
+template <typename DataType>
+template <typename SequenceType>
+void DataIO<DataType>::dataInputParallel(std::string unitType, SequenceType& sequence, WorkerPool& workers)
+{
+    MappedFile input{ unitType + ".csv" };
+    MappedFile inputExtra{ unitType + "_extra.csv" };
+
+    std::vector<std::string_view> lines{ this->splitLines(input.getContent(), &workers) };
+    std::vector<std::string_view> linesExtra{ this->splitLines(inputExtra.getContent(), &workers) };
+    std::vector<size_t> matches{ this->joinExtra(unitType, lines, linesExtra) };
 
-    while (std::getline(input, line) && std::getline(inputExtra, lineExtra))
+    // 1. riadok (nadpisy) sa vynecha
+    size_t rowCount = lines.empty() ? 0 : lines.size() - 1;
+
+    // sloty sa vytvoria vopred, kazde vlakno zapisuje len do svojho useku => poradie zo suboru ostane zachovane
+    size_t firstSlot = sequence.size();
+    sequence.reserveCapacity(firstSlot + rowCount);
+    for (size_t i = 0; i < rowCount; ++i)
     {
-        std::istringstream ssline(line);
-        std::string word{};
-        std::vector<std::string> words{};
+        sequence.insertLast().data_ = nullptr;
+    }
+
+    workers.parallelFor(rowCount, [&](size_t, size_t begin, size_t end)
+        {
+            UnitArena& arena{ this->store.createArena() };      // kazdy usek ma vlastnu arenu, vlakna sa pri alokacii neblokuju
+            for (size_t row = begin + 1; row < end + 1; ++row)
+            {
+                sequence.access(firstSlot + row - 1)->data_ = this->parseUnit(lines[row], matches[row] != NO_MATCH ? linesExtra[matches[row]] : std::string_view{}, arena);
+            }
+        });
+}
+
+template <typename DataType>
+std::vector<size_t> DataIO<DataType>::joinExtra(const std::string& unitType, const std::vector<std::string_view>& lines, const std::vector<std::string_view>& linesExtra)
+{
+    // riadky sa paruju podla kluca, nie podla poradia:
+    //  - ak ma _extra subor v hlavicke ako 1. stlpec "code" alebo "sortNumber", kluc je tento stlpec
+    //  - inak je klucom nazov: altTitle voci officialTitle, nejednoznacny nazov sa doplni o titleQualifier (napr. ", okres Malacky");
+    //    co sa takto nesparuje, paruje sa este podla samotneho nazvu v poradi vyskytu
+    std::string_view words[MAX_FIELDS]{};
+    bool keyed = !linesExtra.empty() && this->splitLine(linesExtra[0], words) > 0 && (words[0] == "code" || words[0] == "sortNumber");
+    size_t keyField = !keyed ? TITLE_FIELD : words[0] == "code" ? 1 : 0;
+    this->extraOffset = keyed ? 1 : 0;
+
+    std::vector<std::string_view> mainKeys(lines.size());
+    std::vector<std::string_view> extraKeys(linesExtra.size());
+    for (size_t row = 1; row < lines.size(); ++row)
+    {
+        size_t wordCount = this->splitLine(lines[row], words);
+        mainKeys[row] = keyField < wordCount ? words[keyField] : std::string_view{};
+    }
+    for (size_t row = 1; row < linesExtra.size(); ++row)
+    {
+        size_t wordCount = this->splitLine(linesExtra[row], words);
+        extraKeys[row] = keyed ? words[0] : wordCount > 1 ? words[1] : std::string_view{};
+    }
+
+    // doplnene kluce musia niekde zit, vektor sa uz nerealokuje, takze string_view na ne ostanu platne
+    std::vector<std::string> qualifiedKeys(!keyed && this->titleQualifier ? lines.size() : 0);
+    if (!qualifiedKeys.empty())
+    {
+        std::unordered_map<std::string_view, size_t> titleCount{};
+        for (size_t row = 1; row < lines.size(); ++row)
+        {
+            ++titleCount[mainKeys[row]];
+        }
+        for (size_t row = 1; row < lines.size(); ++row)
+        {
+            if (titleCount[mainKeys[row]] > 1)
+            {
+                this->splitLine(lines[row], words);
+                qualifiedKeys[row] = std::string(mainKeys[row]) + this->titleQualifier(words[1]);
+                mainKeys[row] = qualifiedKeys[row];
+            }
+        }
+    }
 
-        std::istringstream sslineExtra(lineExtra);
-        std::string wordExtra{};
-        std::vector<std::string> wordsExtra{};
+    std::vector<size_t> matches(lines.size(), NO_MATCH);
+    std::vector<bool> extraMatched(linesExtra.size(), false);
+    this->joinByKey(mainKeys, extraKeys, matches, extraMatched);
 
-        while (std::getline(ssline, word, ';'))
+    if (!keyed)
+    {
+        for (size_t row = 1; row < lines.size(); ++row)
+        {
+            this->splitLine(lines[row], words);
+            mainKeys[row] = words[TITLE_FIELD];
+        }
+        for (size_t row = 1; row < linesExtra.size(); ++row)
         {
-            words.push_back(word);
+            extraKeys[row] = extraKeys[row].substr(0, extraKeys[row].rfind(", okres "));
         }
+        this->joinByKey(mainKeys, extraKeys, matches, extraMatched);
+    }
 
-        while (std::getline(sslineExtra, wordExtra, ';'))
+    for (size_t row = 1; row < lines.size(); ++row)
+    {
+        if (matches[row] == NO_MATCH)
+        {
+            std::cout << "Riadok bez pru v " << unitType << "_extra.csv: " << lines[row] << '\n';
+        }
+    }
+    for (size_t row = 1; row < linesExtra.size(); ++row)
+    {
+        if (!extraMatched[row])
         {
-            wordsExtra.push_back(wordExtra);
+            std::cout << "Riadok bez pru v " << unitType << ".csv: " << linesExtra[row] << '\n';
         }
+    }
 
-        std::stringstream ssnum(words[0]);
-        size_t num{};
-        ssnum >> num;
+    return matches;
+}
 
-        std::stringstream ssnumExtra(wordsExtra[0]);
-        size_t numExtra{};
-        ssnumExtra >> numExtra;
+template <typename DataType>
+void DataIO<DataType>::joinByKey(const std::vector<std::string_view>& mainKeys, const std::vector<std::string_view>& extraKeys, std::vector<size_t>& matches, std::vector<bool>& extraMatched)
+{
+    // hashovaci index sa postavi nad mensou stranou, vacsia strana sa nim prehlada; uz sparovane riadky sa preskakuju
+    bool indexMain = mainKeys.size() < extraKeys.size();
+    const std::vector<std::string_view>& indexed{ indexMain ? mainKeys : extraKeys };
+    const std::vector<std::string_view>& streamed{ indexMain ? extraKeys : mainKeys };
+    auto isMatched = [&](bool mainSide, size_t row) { return mainSide ? matches[row] != NO_MATCH : extraMatched[row]; };
 
-        DataType* dataUnit = new DataType(num, words[1], words[2], words[3], words[4], words.size() < 6 ? "" : words[5], numExtra, wordsExtra.size() < 2 ? "" : wordsExtra[1]);
+    // pre kazdy kluc prvy este nesparovany riadok, next zretazuje dalsie riadky s rovnakym klucom v poradi zo suboru
+    std::unordered_map<std::string_view, size_t> firstWithKey{};
+    std::vector<size_t> next(indexed.size(), NO_MATCH);
+    firstWithKey.reserve(indexed.size());
+    for (size_t row = indexed.size(); row-- > 1;)
+    {
+        if (isMatched(indexMain, row))
+        {
+            continue;
+        }
 
-        insert(dataUnit);
+        auto [position, inserted] = firstWithKey.try_emplace(indexed[row], row);
+        if (!inserted)
+        {
+            next[row] = position->second;
+            position->second = row;
+        }
     }
-}
\ No newline at end of file
+
+    for (size_t row = 1; row < streamed.size(); ++row)
+    {
+        if (isMatched(!indexMain, row))
+        {
+            continue;
+        }
+
+        auto position = firstWithKey.find(streamed[row]);
+        if (position != firstWithKey.end() && position->second != NO_MATCH)
+        {
+            size_t indexedRow = position->second;
+            position->second = next[indexedRow];
+            matches[indexMain ? indexedRow : row] = indexMain ? row : indexedRow;
+            extraMatched[indexMain ? row : indexedRow] = true;
+        }
+    }
+}
+
+template <typename DataType>
+DataType* DataIO<DataType>::parseUnit(std::string_view line, std::string_view lineExtra, UnitArena& arena)
+{
+    std::string_view words[MAX_FIELDS]{};
+    std::string_view wordsExtra[MAX_FIELDS]{};
+
+    size_t wordCount = this->splitLine(line, words);
+    size_t wordExtraCount = lineExtra.empty() ? 0 : this->splitLine(lineExtra, wordsExtra);
+
+    if (wordCount < 5)
+    {
+        throw std::runtime_error("Chyba pri tan zo sboru!");
+    }
+
+    // jednotka bez paru v _extra subore nema materske skoly a jej alternativny nazov je oficialny nazov
+    size_t kindergartenNum = wordExtraCount > this->extraOffset ? this->parseNumber(wordsExtra[this->extraOffset]) : 0;
+    std::string_view altTitle{ wordExtraCount > this->extraOffset + 1 ? wordsExtra[this->extraOffset + 1] : wordExtraCount > 0 ? std::string_view{} : words[TITLE_FIELD] };
+
+    return arena.create(this->parseNumber(words[0]), words[1], words[2], words[3], words[4], wordCount < 6 ? "" : words[5], kindergartenNum, altTitle);
+}
+
+template <typename DataType>
+std::vector<std::string_view> DataIO<DataType>::splitLines(std::string_view content, WorkerPool* workers)
+{
+    std::vector<std::string_view> lines{};
+    std::string_view line{};
+    if (workers == nullptr)
+    {
+        while (this->nextLine(content, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    // subor sa rozdeli na priblizne rovnake useky, hranica kazdeho useku sa posunie za najblizsi koniec riadku
+    size_t chunkCount = workers->getThreadCount();
+    std::vector<size_t> bounds(chunkCount + 1, content.size());
+    bounds[0] = 0;
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        size_t newLine = content.find('\n', content.size() * chunk / chunkCount);
+        bounds[chunk] = newLine == std::string_view::npos ? content.size() : newLine + 1;
+    }
+
+    std::vector<std::vector<std::string_view>> chunkLines(chunkCount);
+    workers->parallelFor(chunkCount, chunkCount, [&](size_t chunk, size_t, size_t)
+        {
+            size_t begin = (std::min)(bounds[chunk], bounds[chunk + 1]);
+            std::string_view part{ content.substr(begin, bounds[chunk + 1] - begin) };
+            std::string_view chunkLine{};
+            while (this->nextLine(part, chunkLine))
+            {
+                chunkLines[chunk].push_back(chunkLine);
+            }
+        });
+
+    for (auto& part : chunkLines)
+    {
+        lines.insert(lines.end(), part.begin(), part.end());
+    }
+    return lines;
+}
+
+template <typename DataType>
+bool DataIO<DataType>::nextLine(std::string_view& content, std::string_view& line)
+{
+    // odsekne z obsahu suboru jeden riadok (bez kopirovania), koncove \r a prazdne riadky sa vynechaju
+    while (!content.empty())
+    {
+        size_t end = content.find('\n');
+        line = content.substr(0, end);
+        content.remove_prefix(end == std::string_view::npos ? content.size() : end + 1);
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        if (!line.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename DataType>
+size_t DataIO<DataType>::splitLine(std::string_view line, std::string_view* fields)
+{
+    // polia ostavaju ukazovat do namapovaneho suboru
+    size_t count = 0;
+    while (count < MAX_FIELDS)
+    {
+        size_t separator = line.find(';');
+        fields[count++] = line.substr(0, separator);
+        if (separator == std::string_view::npos)
+        {
+            break;
+        }
+        line.remove_prefix(separator + 1);
+    }
+    return count;
+}
+
+template <typename DataType>
+size_t DataIO<DataType>::parseNumber(std::string_view field)
+{
+    size_t num{};
+    std::from_chars(field.data(), field.data() + field.size(), num);
+    return num;
+}
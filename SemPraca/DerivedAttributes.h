@@ -0,0 +1,38 @@
+#pragma once
+#include <utility>
+#include "Unit.h"
+#include "Cp1250.h"
+
+// vypocet odvodenych atributov jednotky; vola sa raz pri nacitani jednotky a hodnoty sa ulozia do Unit
+// novy atribut: hodnota v enum DerivedAttribute (Unit.h), funkcia, ktora ho vypocita, a riadok v registri v derive()
+class DerivedAttributes
+{
+public:
+    static void derive(Unit& unit);
+
+private:
+    static size_t countVowels(const Unit& unit);
+};
+
+void DerivedAttributes::derive(Unit& unit)
+{
+    static const std::pair<DerivedAttribute, size_t(*)(const Unit&)> registry[] = {
+        { VOWELS_COUNT, &DerivedAttributes::countVowels },
+    };
+    static_assert(sizeof(registry) / sizeof(registry[0]) == DERIVED_ATTRIBUTE_COUNT, "Kad odvoden atribt mus ma funkciu na vpoet.");
+
+    for (const auto& [attribute, compute] : registry)
+    {
+        unit.setDerived(attribute, compute(unit));
+    }
+}
+
+size_t DerivedAttributes::countVowels(const Unit& unit)
+{
+    size_t vowelCount{ 0 };
+    for (char letter : unit.getOfficialTitle())
+    {
+        vowelCount += Cp1250::isVowel(letter) ? 1 : 0;
+    }
+    return vowelCount;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <libds/amt/explicit_hierarchy.h>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "WorkerPool.h"
+
+// zmrazena kopia viaccestnej hierarchie v poradi pre-order: vrchol je jeho poradie, podstrom vrchola je suvisly usek [vrchol, koniec)
+// otec, synovia a hlbka su v poliach => navigacia aj dotazy nad podstromom bez prechodu cez bloky MWEHBlock
+// po zmene povodnej hierarchie sa musi vytvorit znova (build)
+template <typename DataType>
+class FlatHierarchy
+{
+public:
+    static constexpr size_t NONE = UINT32_MAX;
+
+    void build(const ds::amt::MultiWayExplicitHierarchy<DataType>& hierarchy);
+
+    size_t size() const { return this->data.size(); };
+    size_t accessRoot() const { return 0; };
+    size_t accessParent(size_t node) const { return this->parents[node]; };
+    size_t accessSon(size_t node, size_t sonOrder) const { return this->sons[this->sonOffsets[node] + sonOrder]; };
+    size_t degree(size_t node) const { return this->sonOffsets[node + 1] - this->sonOffsets[node]; };
+    bool isRoot(size_t node) const { return node == 0; };
+    bool isLeaf(size_t node) const { return this->degree(node) == 0; };
+    size_t getDepth(size_t node) const { return this->depths[node]; };
+    // usek vrcholov podstromu [node, za poslednym potomkom)
+    std::pair<size_t, size_t> subtree(size_t node) const { return { node, this->ends[node] }; };
+    const DataType& access(size_t node) const { return this->data[node]; };
+
+    // paralelny prechod podstromu node po ulohach s priblizne taskRows vrcholmi, ulohu tvoria cele podstromy (vacsie sa rozdelia na synov)
+    // visitor(vrchol, vysledok ulohy) sa vola v pre-order v ramci ulohy; vysledky uloh sa spoja merge(ciel, zdroj) v poradi pre-order
+    // vysledok je az po prehliadke celeho podstromu => oplati sa len pri velkom podstrome, inak je lacnejsi sekvencny prechod
+    template <typename ResultType, typename VisitorType, typename MergeType>
+    ResultType traverseParallel(size_t node, size_t taskRows, WorkerPool& workers, VisitorType visitor, MergeType merge) const;
+
+private:
+    // ulohy ako suvisle useky pre-order [zaciatok, koniec), idu po sebe => spracovanie v poradi uloh zachova poradie sekvencneho prechodu
+    std::vector<std::pair<size_t, size_t>> subtreeTasks(size_t node, size_t taskRows) const;
+
+private:
+    std::vector<DataType> data{};
+    std::vector<uint32_t> ends{};
+    std::vector<uint32_t> parents{};
+    std::vector<uint16_t> depths{};
+    std::vector<uint32_t> sonOffsets{};         // synovia vrchola i su sons[sonOffsets[i], sonOffsets[i + 1])
+    std::vector<uint32_t> sons{};
+};
+
+template <typename DataType>
+void FlatHierarchy<DataType>::build(const ds::amt::MultiWayExplicitHierarchy<DataType>& hierarchy)
+{
+    using BlockType = ds::amt::MWEHBlock<DataType>;
+
+    size_t nodeCount = hierarchy.size();
+    this->data.clear();
+    this->data.reserve(nodeCount);
+    this->ends.assign(nodeCount, 0);
+    this->parents.assign(nodeCount, static_cast<uint32_t>(NONE));
+    this->depths.assign(nodeCount, 0);
+    this->sonOffsets.assign(nodeCount + 1, 0);
+    this->sons.assign(nodeCount > 0 ? nodeCount - 1 : 0, 0);
+    if (nodeCount == 0)
+    {
+        return;
+    }
+
+    // pre-order s vlastnym zasobnikom (vrchol, poradie dalsieho syna); vrchol dostane cislo pri vstupe, koniec useku pri vystupe
+    std::vector<std::pair<const BlockType*, size_t>> stack{ { hierarchy.accessRoot(), 0 } };
+    this->data.push_back(hierarchy.accessRoot()->data_);
+    std::vector<uint32_t> nodes{ 0 };           // cisla vrcholov na zasobniku
+    uint32_t nextSon{ 0 };
+    while (!stack.empty())
+    {
+        auto& [block, sonOrder] = stack.back();
+        uint32_t node = nodes.back();
+        if (sonOrder == 0)
+        {
+            // vrcholy sa cisluju v poradi vstupu => synovia vrchola i nasleduju hned za synmi vrchola i - 1
+            this->sonOffsets[node] = nextSon;
+            nextSon += static_cast<uint32_t>(hierarchy.degree(*block));
+        }
+
+        if (sonOrder == hierarchy.degree(*block))
+        {
+            this->ends[node] = static_cast<uint32_t>(this->data.size());
+            stack.pop_back();
+            nodes.pop_back();
+            continue;
+        }
+
+        const BlockType* son = hierarchy.accessSon(*block, sonOrder);
+        uint32_t sonNode = static_cast<uint32_t>(this->data.size());
+        this->sons[this->sonOffsets[node] + sonOrder] = sonNode;
+        ++sonOrder;
+
+        this->data.push_back(son->data_);
+        this->parents[sonNode] = node;
+        this->depths[sonNode] = static_cast<uint16_t>(this->depths[node] + 1);
+        stack.emplace_back(son, 0);
+        nodes.push_back(sonNode);
+    }
+    this->sonOffsets[nodeCount] = nextSon;
+}
+
+template <typename DataType>
+template <typename ResultType, typename VisitorType, typename MergeType>
+ResultType FlatHierarchy<DataType>::traverseParallel(size_t node, size_t taskRows, WorkerPool& workers, VisitorType visitor, MergeType merge) const
+{
+    std::vector<std::pair<size_t, size_t>> tasks = this->subtreeTasks(node, taskRows);
+    std::vector<ResultType> results(tasks.size());
+    workers.parallelFor(tasks.size(), tasks.size(), [&](size_t task, size_t, size_t)
+        {
+            for (size_t current = tasks[task].first; current < tasks[task].second; ++current)
+            {
+                visitor(current, results[task]);
+            }
+        });
+
+    ResultType merged{};
+    for (ResultType& taskResult : results)
+    {
+        merge(merged, taskResult);
+    }
+    return merged;
+}
+
+template <typename DataType>
+std::vector<std::pair<size_t, size_t>> FlatHierarchy<DataType>::subtreeTasks(size_t node, size_t taskRows) const
+{
+    // podstrom do taskRows vrcholov sa preskoci naraz, vacsi vrchol sa vezme sam a pokracuje sa jeho prvym synom;
+    // uloha sa uzavrie, ked ma aspon taskRows vrcholov
+    std::vector<std::pair<size_t, size_t>> tasks{};
+    size_t taskBegin{ node };
+    for (size_t current = node, end = this->ends[node]; current < end;)
+    {
+        current = this->ends[current] - current > taskRows ? current + 1 : this->ends[current];
+        if (current - taskBegin >= taskRows || current == end)
+        {
+            tasks.emplace_back(taskBegin, current);
+            taskBegin = current;
+        }
+    }
+    return tasks;
+}
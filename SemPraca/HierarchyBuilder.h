@@ -0,0 +1,75 @@
+#pragma once
+#include <libds/amt/explicit_hierarchy.h>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+// hromadne vytvorenie viaccestnej hierarchie po urovniach (kraje, okresy, obce), kazda uroven je zoradena podla otcov
+// kurzor ukazuje na otvoreneho otca v predchadzajucej urovni a posuva sa len dopredu => bez opakovaneho zostupu od korena
+// synovia sa pridavaju vzdy na koniec (O(1)), kapacita ich zoznamu sa vopred rezervuje podla pocitacieho prechodu
+template <typename DataType>
+class HierarchyBuilder
+{
+public:
+    using BlockType = ds::amt::MWEHBlock<DataType>;
+
+    // koren uz musi existovat, prva uroven sa zavesi pod neho
+    HierarchyBuilder(ds::amt::MultiWayExplicitHierarchy<DataType>& hierarchy) : hierarchy(hierarchy), parents{ hierarchy.accessRoot() } {};
+
+    // prida uroven z [begin, end): po sebe iduce data s rovnakym klucom maju spolocneho otca,
+    // zmena kluca posunie kurzor na dalsi vrchol predchadzajucej urovne
+    template <typename IteratorType, typename GroupKeyType>
+    void appendLevel(IteratorType begin, IteratorType end, GroupKeyType groupKey);
+
+private:
+    ds::amt::MultiWayExplicitHierarchy<DataType>& hierarchy;
+    std::vector<BlockType*> parents;            // vrcholy poslednej vytvorenej urovne v poradi vytvorenia
+};
+
+template <typename DataType>
+template <typename IteratorType, typename GroupKeyType>
+void HierarchyBuilder<DataType>::appendLevel(IteratorType begin, IteratorType end, GroupKeyType groupKey)
+{
+    // pocitaci prechod: dlzky skupin = pocty synov jednotlivych otcov
+    std::vector<size_t> sonCounts{};
+    size_t sonCount{ 0 };
+    std::decay_t<decltype(groupKey(*begin))> previousKey{};     // kluc predchadzajuceho riadku, porovnava sa len pri neprazdnom sonCounts
+    for (IteratorType it = begin; it != end; ++it, ++sonCount)
+    {
+        auto key = groupKey(*it);
+        if (sonCounts.empty() || key != previousKey)
+        {
+            sonCounts.push_back(0);
+        }
+        previousKey = key;
+        ++sonCounts.back();
+    }
+    if (sonCounts.size() > this->parents.size())
+    {
+        throw std::out_of_range("Jednotka nem v hierarchii otca!");
+    }
+
+    for (size_t i = 0; i < sonCounts.size(); ++i)
+    {
+        this->parents[i]->sons_->reserveCapacity(this->hierarchy.degree(*this->parents[i]) + sonCounts[i]);
+    }
+
+    // prechod s kurzorom: i-ta skupina patri i-temu otcovi, syn sa prida na koniec jeho zoznamu
+    std::vector<BlockType*> sons{};
+    sons.reserve(sonCount);
+    size_t cursor{ 0 };
+    size_t remaining{ sonCounts.empty() ? 0 : sonCounts.front() };
+    for (IteratorType it = begin; it != end; ++it, --remaining)
+    {
+        if (remaining == 0)
+        {
+            remaining = sonCounts[++cursor];
+        }
+        BlockType& parent = *this->parents[cursor];
+        BlockType& son = this->hierarchy.emplaceSon(parent, this->hierarchy.degree(parent));
+        son.data_ = *it;
+        sons.push_back(&son);
+    }
+
+    this->parents = std::move(sons);
+}
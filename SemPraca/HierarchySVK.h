@@ -1,170 +1,136 @@
 #pragma once
 #include <libds/amt/explicit_hierarchy.h>
 #include "Unit.h"
+#include "HierarchyBuilder.h"
+#include "FlatHierarchy.h"
+#include "SubtreeAggregates.h"
+#include "NodeIndex.h"
+#include "IS.h"
+#include "UnitColumns.h"
+#include "TrigramIndex.h"
+#include "PrefixIndex.h"
+#include "KindergartenIndex.h"
+#include "QueryCache.h"
+#include "ResultCursor.h"
 #include "Algorithm.h"
 #include "Sort.h"
+#include "WorkerPool.h"
 #include <string>
+#include <vector>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 
-struct IteratorWrapper
-{
-    ds::amt::Hierarchy<ds::amt::MWEHBlock<Unit*>>::PreOrderHierarchyIterator moveIter(ds::amt::MultiWayExplicitHierarchy<Unit*>& hierarchy, ds::amt::MWEHBlock<Unit*>*& currBlock, int sonIndex = -2)
-    {
-        if (sonIndex != -2)
-        {
-            if (sonIndex == -1)
-            {
-                currBlock = hierarchy.accessParent(*currBlock);
-            }
-            else
-            {
-                currBlock = hierarchy.accessSon(*currBlock, sonIndex);
-            }
-        }
-        ds::amt::Hierarchy<ds::amt::MWEHBlock<Unit*>>::PreOrderHierarchyIterator currIter(&hierarchy, currBlock);
-        return currIter;
-    }
-};
-
 template <typename ISType>
 class HierarchySVK
 {
 public:
-	HierarchySVK(ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities);
+	HierarchySVK(ImplicitSequences& IS, ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities);
+	HierarchySVK(const HierarchySVK&) = delete;                 // index je prihlaseny u vlastnika jednotiek svojou adresou
+	HierarchySVK& operator=(const HierarchySVK&) = delete;
 	~HierarchySVK();
 	void navigateHierarchy();
+    // jednotky z podstromu vrchola node (poradie v pre-order) vyhovujuce operacii s parametrom (pri 'r' "a-b"), vytvaraju sa az pri prechode kurzorom
+    ResultCursor findUnits(size_t node, char operation, const std::string& parameter);
+    // vrchol na ceste poradovych cisel synov od korena (od 1, oddelene '/'), prazdna cesta je koren
+    // prvy usek cesty moze byt adresa vrchola, od ktoreho cesta pokracuje: @kod alebo #typ:poradoveCislo (napr. "@SK0101/3")
+    size_t accessNode(const std::string& path);
+    // vrchol jednotky podla kodu / typu a poradoveho cisla v O(1)
+    size_t findNode(std::string_view code) const;
+    size_t findNode(size_t type, size_t sortNumber) const;
+    Unit* accessUnit(size_t node) const { return flat.access(node); };
+    // zmeni pocet materskych skol jednotky vrchola node cez vlastnika jednotiek (indexy oboch urovni aj ulozene vysledky) a prepocita suhrny predkov
+    void setKindergartenNum(size_t node, size_t kindergartenNum);
+    size_t getAggregate(size_t node, SubtreeAggregate aggregate) const { return aggregates.get(node, aggregate); };
+    // zavesi kraje, okresy a obce pod existujuci koren hierarchy; pouziva ho aj benchmark, aby meral rovnaku hierarchiu
+    static void loadUnits(ds::amt::MultiWayExplicitHierarchy<Unit*>& hierarchy, ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities);
 
 private:
-    void loadUnits(ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities);
-    void beforeLoad(size_t fileNum, int& indexRegion, int& indexDistrict, int& indexMunicipality, std::string& region, std::string& district, size_t& n);
     void currDesc(size_t& i);
-    void toSortOrNotToSort(ds::amt::ImplicitSequence<Unit*>& processed);
-    void whereDoIGo(ds::amt::MultiWayExplicitHierarchy<Unit*>& hierarchy, ds::amt::MWEHBlock<Unit*>*& currBlock, size_t& i);
+    void toSortOrNotToSort(const ResultCursor& found);
+    void printAggregates(size_t node);
+    void whereDoIGo(const FlatHierarchy<Unit*>& hierarchy, size_t& currNode, size_t& i);
 
 private:
+    // dotaz na typ ide paralelne az nad PARALLEL_MIN_ROWS riadkov podstromu (cele Slovensko ma ~3100 => sekvencne), uloha ma ~PARALLEL_TASK_ROWS riadkov
+    // hranica je nad velkostou dat: pri porovnani typu v stlpci sa paralelny prechod neoplati, kym nema kazde vlakno aspon niekolko tisic riadkov
+    static constexpr size_t PARALLEL_MIN_ROWS = 1 << 16;
+    static constexpr size_t PARALLEL_TASK_ROWS = 1 << 12;
+
 	ds::amt::MultiWayExplicitHierarchy<Unit*> hierarchy;
-    ds::amt::MWEHBlock<Unit*>* currBlock;
-	Algorithm<Unit*, ds::amt::Hierarchy<ds::amt::MWEHBlock<Unit*>>::PreOrderHierarchyIterator> algorithm;
+    FlatHierarchy<Unit*> flat{};    // zmrazena kopia v poradi pre-order, navigacia aj dotazy idu cez nu
+    size_t currNode{ 0 };
+    UnitColumns columns{};          // jednotky v poradi pre-order => riadok = vrchol v flat, podstrom vrchola je suvisly usek riadkov
+    TrigramIndex trigrams{};        // nad nazvami v poradi pre-order, vyhladavanie "obsahuje" sa obmedzi na usek podstromu
+    PrefixIndex prefixes{};         // to iste pre vyhladavanie "zacina"
+    KindergartenIndex kindergartens{};  // a pre dotazy na pocet materskych skol
+    SubtreeAggregates aggregates{};     // suhrny obci podstromu kazdeho vrchola
+    NodeIndex nodes{};                  // vrchol podla kodu a poradoveho cisla jednotky
+    ImplicitSequences& IS;          // vlastnik jednotiek, meni pocty materskych skol vo vsetkych indexoch
+    QueryCache& cache;
+    WorkerPool& workers;            // celostatne dotazy (z korena) idu paralelne po podstromoch
+	Algorithm<UnitRow, UnitColumns::RowIterator> algorithm;
     Sort<Unit*> sort{};
 };
 
 template <typename ISType>
-HierarchySVK<ISType>::HierarchySVK(ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities)
+HierarchySVK<ISType>::HierarchySVK(ImplicitSequences& IS, ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities) : IS(IS), cache(IS.getCache()), workers(IS.getWorkers())
 { 
-    hierarchy.emplaceRoot().data_ = new Unit(1, "SK", "Slovensk republika", "Slovensko", "Slovensko", "SVK", 3102, "Slovensk republika");
-	this->loadUnits(ISregions, ISdistricts, ISmunicipalities);
-    currBlock = hierarchy.accessRoot();
+    hierarchy.emplaceRoot().data_ = IS.getStore().create(1, "SK", "Slovensk republika", "Slovensko", "Slovensko", "SVK", 3102, "Slovensk republika");
+	loadUnits(hierarchy, ISregions, ISdistricts, ISmunicipalities);
+    flat.build(hierarchy);
+    nodes.build(flat);
+    columns.reserve(flat.size());
+    for (size_t node = 0; node < flat.size(); ++node)
+    {
+        columns.insertLast(flat.access(node));
+    }
+    trigrams.build(columns);
+    prefixes.build(columns);
+    kindergartens.build(columns);
+    IS.registerIndex(kindergartens);
+    aggregates.build(flat);
+    currNode = flat.accessRoot();
 }
 
 template <typename ISType>
-void HierarchySVK<ISType>::loadUnits(ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities)
+void HierarchySVK<ISType>::loadUnits(ds::amt::MultiWayExplicitHierarchy<Unit*>& hierarchy, ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities)
 {
-	size_t n;				// n = poradie syna u svojho otca
-	int indexRegion;
-	int indexDistrict;
-	int indexMunicipality;
-	std::string region;
-	std::string district;
-
-	this->beforeLoad(0, indexRegion, indexDistrict, indexMunicipality, region, district, n);
-	for (auto unit : ISregions)
-	{
-		hierarchy.emplaceSon(*hierarchy.accessRoot(), n).data_ = unit;
-		++n;
-	}
-
-	this->beforeLoad(1, indexRegion, indexDistrict, indexMunicipality, region, district, n);
-	for (auto unit : ISdistricts)
-	{
-		std::string newRegion = unit->getCode().substr(3, 2);
-		indexRegion = region == newRegion ? indexRegion : indexRegion + 1;
-		indexDistrict = region == newRegion ? indexDistrict + 1 : 0;
-		region = newRegion;
-		hierarchy.emplaceSon((*hierarchy.accessSon(*hierarchy.accessRoot(), indexRegion)), indexDistrict).data_ = unit;
-	}
-
-	this->beforeLoad(2, indexRegion, indexDistrict, indexMunicipality, region, district, n);
-	for (auto unit : ISmunicipalities)
-	{
-		std::string newRegion = unit->getCode().substr(3, 2);
-		std::string newDistrict = unit->getCode().substr(3, 3);
-		if (region != newRegion)								// ak prejde na novy kraj
-		{
-			++indexRegion;
-			indexDistrict = 0;
-			indexMunicipality = 0;
-		}
-		else
-		{														// ak ostava vramci toho isteho kraja
-			if (district != newDistrict)							// ak prejde na novy okres
-			{
-				++indexDistrict;
-				indexMunicipality = 0;
-			}
-			else
-			{														// ak ostava vramci toho isteho okresu
-				++indexMunicipality;
-			}
-		}
-		if (newRegion == "ZZ" && unit->getNote() != "")
+	// kazda uroven je zoradena podla otcov => otec sa zmeni, ked sa zmeni kraj / okres
+	HierarchyBuilder<Unit*> builder{ hierarchy };
+	builder.appendLevel(ISregions.begin(), ISregions.end(), [](Unit*) { return 0; });
+	builder.appendLevel(ISdistricts.begin(), ISdistricts.end(), [](Unit* unit) { return unit->getRegionId(); });
+	builder.appendLevel(ISmunicipalities.begin(), ISmunicipalities.end(), [](Unit* unit)
 		{
-			indexDistrict = 1;
-			indexMunicipality = 0;
-		}
-		region = newRegion;
-		district = newDistrict;
-		hierarchy.emplaceSon((*hierarchy.accessSon(*hierarchy.accessSon(*hierarchy.accessRoot(), indexRegion), indexDistrict)), indexMunicipality).data_ = unit;
-	}
-}
-
-template <typename ISType>
-void HierarchySVK<ISType>::beforeLoad(size_t fileNum, int& indexRegion, int& indexDistrict, int& indexMunicipality, std::string& region, std::string& district, size_t& n)
-{
-	if (fileNum == 0)
-	{							// regions
-		n = 0;
-	}
-	else if (fileNum == 1)
-	{							// districts
-		region = "10";
-		indexRegion = 0;
-		indexDistrict = -1;
-	}
-	else
-	{							// municipalities
-		region = "10";
-		district = "101";
-		indexRegion = 0;
-		indexDistrict = 0;
-		indexMunicipality = -1;
-	}
+			// kraj Zahranicie ma dva okresy s rovnakym cislom, obec s poznamkou patri do druheho
+			bool secondForeign = unit->getRegionId() == Unit::FOREIGN_REGION && !unit->getNote().empty();
+			return unit->getDistrictId() * 2 + (secondForeign ? 1 : 0);
+		});
 }
 
 template<typename ISType>
 void HierarchySVK<ISType>::currDesc(size_t& i)
 {
-    std::cout << "Nachdzate sa vo vrchole " << (*currBlock->data_).getOfficialTitle() << "\n";
-    if (hierarchy.isRoot(*currBlock))
+    std::cout << "Nachdzate sa vo vrchole " << flat.access(currNode)->getOfficialTitle() << "\n";
+    if (flat.isRoot(currNode))
     {
         std::cout << "\tAktulny vrchol je kore. Nemete sa posun na otca.\n";
     }
     else
     {
-        std::cout << "\tOtec aktulneho vrchola:\n\t\t[0]\t" << (*currBlock->parent_->data_).getOfficialTitle() << "\n";
+        std::cout << "\tOtec aktulneho vrchola:\n\t\t[0]\t" << flat.access(flat.accessParent(currNode))->getOfficialTitle() << "\n";
     }
 
-    if (hierarchy.isLeaf(*currBlock))
+    if (flat.isLeaf(currNode))
     {
         std::cout << "\tAktulny vrchol je list. Nemete sa posun na syna.\n";
     }
     else
     {
         std::cout << "\tMnoina synov aktulneho vrchola:\n";
-        for (auto son : *currBlock->sons_)
+        for (size_t son = 0; son < flat.degree(currNode); ++son)
         {
-            std::cout << "\t\t[" << i << "]\t" << (*son->data_).getOfficialTitle() << "\n";
+            std::cout << "\t\t[" << i << "]\t" << flat.access(flat.accessSon(currNode, son))->getOfficialTitle() << "\n";
             ++i;
         }
     }
@@ -174,13 +140,9 @@ template<typename ISType>
 void HierarchySVK<ISType>::navigateHierarchy()
 {
     std::cout << "\n=== ROVE 2 ===\n\n";
-    ds::amt::Hierarchy<ds::amt::MWEHBlock<Unit*>>::PreOrderHierarchyIterator lastIter(&hierarchy, nullptr);
     size_t cont{ 1 };
     while (cont)
     {
-        auto currIter = IteratorWrapper().moveIter(hierarchy, currBlock);
-        ds::amt::ImplicitSequence<Unit*> processedUnits{};
-        std::function<void(Unit* insertedUnit)> insert = [&](Unit* insertedUnit) { processedUnits.insertLast().data_ = insertedUnit; };
         
         size_t i{ 1 };
         this->currDesc(i);
@@ -190,8 +152,8 @@ void HierarchySVK<ISType>::navigateHierarchy()
         {
             errInput = 0;
             char input;
-            InputCheck().checkInput(input, "Zadajte: presun na vrchol [v] | obsahuje [o] | zana na [z] | je typu [t] | m aspo n materskch kl [m] | koniec [x]: ", "Nevhodn vstup. Zadajte znova: ",
-                [&input]() -> bool { return input != 'x' && input != 'o' && input != 'z' && input != 't' && input != 'v' && input != 'm'; });
+            InputCheck().checkInput(input, "Zadajte: presun na vrchol [v] | obsahuje [o] | zana na [z] | obsahuje / zana bez diakritiky [O / Z] | je typu [t] | m aspo n materskch kl [m] | poet materskch kl od a do b [r] | k jednotiek s najviac materskmi kolami [k] | shrn podstromu [a] | koniec [x]: ", "Nevhodn vstup. Zadajte znova: ",
+                [&input]() -> bool { return input != 'x' && input != 'a' && input != 'o' && input != 'z' && input != 'O' && input != 'Z' && input != 't' && input != 'v' && input != 'm' && input != 'r' && input != 'k'; });
             
             try
             {
@@ -203,65 +165,60 @@ void HierarchySVK<ISType>::navigateHierarchy()
 
                 case 'o':
                 case 'z':
+                case 'O':
+                case 'Z':
+                case 't':
+                case 'm':
+                case 'r':
+                case 'k':
                 {
-                    std::string searchedStr;
-                    std::cout << "Zadajte hadan reazec: ";
-                    std::getline(std::cin, searchedStr);
-                        
-                    if (input == 'o')
+                    // parameter dotazu ako text, pri 'r' "a-b"
+                    std::string parameter{};
+                    std::string numInput{};
+                    if (input == 'o' || input == 'z' || input == 'O' || input == 'Z')
+                    {
+                        std::cout << "Zadajte hadan reazec: ";
+                        std::getline(std::cin, parameter);
+                    }
+                    else if (input == 't')
+                    {
+                        size_t type;
+                        InputCheck().checkInput(type, "Zadajte typ: kraj [1] | okres [2] | obec [3]: ", "Nevhodn zadan typ. Zadajte znova: ",
+                            [&type]() -> bool { return type != 1 && type != 2 && type != 3; });
+                        parameter = std::to_string(type);
+                    }
+                    else if (input == 'k')
                     {
-                        std::function predicateContains = [&](Unit* testedUnit) -> bool { return (*testedUnit).containsStr(searchedStr); };
-                        // prehliadka na containsStr
-                        algorithm.findAndProcess(currIter, lastIter, predicateContains, insert);
+                        std::cout << "Zadajte poet jednotiek: ";
+                        std::getline(std::cin, numInput);
+                        parameter = std::to_string(static_cast<size_t>(std::stoi(numInput)));
                     }
                     else
                     {
-                        std::function predicateStartsWith = [&](Unit* testedUnit) -> bool { return (*testedUnit).startsWithStr(searchedStr); };
-                        // prehliadka na stratsWithStr
-                        algorithm.findAndProcess(currIter, lastIter, predicateStartsWith, insert);
+                        std::cout << "Zadajte minimlny poet materskch kl: ";
+                        std::getline(std::cin, numInput);
+                        parameter = std::to_string(static_cast<size_t>(std::stoi(numInput)));
+                        if (input == 'r')
+                        {
+                            std::cout << "Zadajte maximlny poet materskch kl: ";
+                            std::getline(std::cin, numInput);
+                            parameter += '-' + std::to_string(static_cast<size_t>(std::stoi(numInput)));
+                        }
                     }
 
-                    this->toSortOrNotToSort(processedUnits);
+                    this->toSortOrNotToSort(this->findUnits(currNode, input, parameter));
                     std::cout << '\n';
 
                     break;
                 }
-                case 't':
-                {
-                    size_t type;
-                    InputCheck().checkInput(type, "Zadajte typ: kraj [1] | okres [2] | obec [3]: ", "Nevhodn zadan typ. Zadajte znova: ",
-                        [&type]() -> bool { return type != 1 && type != 2 && type != 3; });
-
-                    std::function predicateHasType = [&](Unit* testedUnit) -> bool { return (*testedUnit).hasType(type); };
-                    algorithm.findAndProcess(currIter, lastIter, predicateHasType, insert);
-
-                    this->toSortOrNotToSort(processedUnits);
+                case 'a':
+                    this->printAggregates(currNode);
                     std::cout << '\n';
-
                     break;
-                }
-                case 'm':
-                {
-                    size_t kindergartenNum{};
-                    std::string numInput;
-                    std::cout << "Zadajte minimlny poet materskch kl: ";
-                    std::getline(std::cin, numInput);
-                    kindergartenNum = std::stoi(numInput);
-
-                    std::function<bool(Unit* testedUnit)> atLeastNKindergartens = [&](Unit* testedUnit) { return (*testedUnit).getKindergartenNum() >= kindergartenNum; };
-
-                    algorithm.findAndProcess(currIter, lastIter,
-                        atLeastNKindergartens,
-                        insert);
-
-                    this->toSortOrNotToSort(processedUnits);
-                    std::cout << '\n';
 
-                    break;
-                }
                 case 'v':
                 {
-                    this->whereDoIGo(hierarchy, currBlock, i);
+                    this->whereDoIGo(flat, currNode, i);
                     std::cout << '\n';
 
                     break;
@@ -279,7 +236,7 @@ void HierarchySVK<ISType>::navigateHierarchy()
 }
 
 template<typename ISType>
-void HierarchySVK<ISType>::toSortOrNotToSort(ds::amt::ImplicitSequence<Unit*>& processed)
+void HierarchySVK<ISType>::toSortOrNotToSort(const ResultCursor& found)
 {
     char sortIn;
     InputCheck().checkInput(sortIn, "Zadajte: vypsa neutrieden [n] | utriedi [u]: ", "Nesprvny vstup. Zadajte znova: ",
@@ -287,25 +244,182 @@ void HierarchySVK<ISType>::toSortOrNotToSort(ds::amt::ImplicitSequence<Unit*>& p
 
     if (sortIn == 'u')
     {
+        // triedenie potrebuje vsetky jednotky naraz
+        ds::amt::ImplicitSequence<Unit*> processed{};
+        found.materialize(processed);
         sort.chooseSort(processed);
     }
     else
     {
-        for (auto unit : processed)
+        found.forEach([](Unit* unit) { std::cout << '\t' << *unit << '\n'; });
+    }
+}
+
+template<typename ISType>
+void HierarchySVK<ISType>::printAggregates(size_t node)
+{
+    std::cout << "\tPoet obc: " << aggregates.get(node, MUNICIPALITY_COUNT) << "\n";
+    std::cout << "\tPoet materskch kl: " << aggregates.get(node, KINDERGARTEN_SUM) << "\n";
+    if (!aggregates.isEmpty(node))
+    {
+        std::cout << "\tNajmenej materskch kl v obci: " << aggregates.get(node, KINDERGARTEN_MIN) << "\n";
+        std::cout << "\tNajviac materskch kl v obci: " << aggregates.get(node, KINDERGARTEN_MAX) << "\n";
+    }
+}
+
+template<typename ISType>
+void HierarchySVK<ISType>::setKindergartenNum(size_t node, size_t kindergartenNum)
+{
+    IS.setKindergartenNum(flat.access(node), kindergartenNum);
+    aggregates.update(node);
+}
+
+template<typename ISType>
+ResultCursor HierarchySVK<ISType>::findUnits(size_t node, char operation, const std::string& parameter)
+{
+    if (node >= flat.size())
+    {
+        throw std::out_of_range("Neplatn vrchol hierarchie!");
+    }
+
+    // prehliadka podstromu vrchola = prechod cez jeho usek riadkov
+    auto [firstRow, endRow] = flat.subtree(node);
+
+    // opakovany dotaz sa vezme z vyrovnavacej pamate, rozsahom je jednotka vrchola
+    return ResultCursor::cached(cache, { flat.access(node), operation, parameter }, [this, node, operation, parameter, firstRow = firstRow, endRow = endRow](const ResultCursor::Yield& yield)
+        {
+            auto insert = [&](UnitRow& insertedRow) { return yield(insertedRow.getUnit()); };
+            switch (operation)
+            {
+            case 'o':
+            case 'O':
+                // containsStr cez trigramovy index, 'O' bez ohladu na diakritiku a velkost pismen
+                trigrams.findContaining(parameter, operation == 'O' ? FOLDED_MATCH : EXACT_MATCH, firstRow, endRow, insert);
+                break;
+            case 'z':
+            case 'Z':
+                // startsWithStr cez zoradeny index nazvov
+                prefixes.findStartingWith(parameter, operation == 'Z' ? FOLDED_MATCH : EXACT_MATCH, firstRow, endRow, insert);
+                break;
+            case 't':
+            {
+                size_t type = std::stoull(parameter);
+                auto predicateHasType = [&](UnitRow& testedRow) -> bool { return testedRow.hasType(type); };
+                if (endRow - firstRow >= PARALLEL_MIN_ROWS)
+                {
+                    // velky podstrom na vsetkych jadrach; zhody sa spoja v poradi pre-order => rovnaky vysledok ako sekvencne,
+                    // ale podstrom sa prehliadne cely aj pri limite strany
+                    std::vector<Unit*> found = flat.traverseParallel<std::vector<Unit*>>(node, PARALLEL_TASK_ROWS, workers,
+                        [&](size_t row, std::vector<Unit*>& taskFound)
+                        {
+                            UnitRow testedRow = columns.access(row);
+                            if (predicateHasType(testedRow))
+                            {
+                                taskFound.push_back(testedRow.getUnit());
+                            }
+                        },
+                        [](std::vector<Unit*>& target, std::vector<Unit*>& source) { target.insert(target.end(), source.begin(), source.end()); });
+                    for (Unit* unit : found)
+                    {
+                        if (!yield(unit))
+                        {
+                            break;
+                        }
+                    }
+                    break;
+                }
+                algorithm.findAndProcess(columns.rowIterator(firstRow), columns.rowIterator(endRow), predicateHasType, insert);
+                break;
+            }
+            // prahove dotazy cez index podla poctu materskych skol, obmedzene na usek podstromu
+            case 'k':
+                kindergartens.findTop(std::stoull(parameter), firstRow, endRow, insert);
+                break;
+            case 'm':
+                kindergartens.findAtLeast(std::stoull(parameter), firstRow, endRow, insert);
+                break;
+            case 'r':
+                kindergartens.findBetween(std::stoull(parameter), std::stoull(parameter.substr(parameter.find('-') + 1)), firstRow, endRow, insert);
+                break;
+            default:
+                throw std::invalid_argument("Neznma opercia!");
+            }
+        });
+}
+
+template<typename ISType>
+size_t HierarchySVK<ISType>::accessNode(const std::string& path)
+{
+    size_t node{ flat.accessRoot() };
+    std::istringstream sonIndexes{ path };
+    std::string sonIndex{};
+    if (!path.empty() && (path.front() == '@' || path.front() == '#'))
+    {
+        std::getline(sonIndexes, sonIndex, '/');
+        if (sonIndex.front() == '@')
         {
-            std::cout << '\t' << *unit << '\n';
+            node = this->findNode(std::string_view{ sonIndex }.substr(1));
         }
+        else
+        {
+            size_t separator = sonIndex.find(':');
+            if (separator == std::string::npos)
+            {
+                throw std::invalid_argument("Nesprvna adresa vrchola: " + sonIndex);
+            }
+            node = this->findNode(std::stoull(sonIndex.substr(1, separator - 1)), std::stoull(sonIndex.substr(separator + 1)));
+        }
+    }
+
+    while (std::getline(sonIndexes, sonIndex, '/'))
+    {
+        size_t index = std::stoull(sonIndex);
+        if (index < 1 || index > flat.degree(node))
+        {
+            throw std::out_of_range("Neplatn cesta v hierarchii: " + path);
+        }
+        node = flat.accessSon(node, index - 1);
+    }
+    return node;
+}
+
+template<typename ISType>
+size_t HierarchySVK<ISType>::findNode(std::string_view code) const
+{
+    size_t node = nodes.findByCode(code);
+    if (node == NodeIndex::NONE)
+    {
+        throw std::out_of_range("Jednotka s kdom " + std::string(code) + " nie je v hierarchii!");
+    }
+    return node;
+}
+
+template<typename ISType>
+size_t HierarchySVK<ISType>::findNode(size_t type, size_t sortNumber) const
+{
+    size_t node = nodes.findBySortNumber(type, sortNumber);
+    if (node == NodeIndex::NONE)
+    {
+        throw std::out_of_range("Jednotka typu " + std::to_string(type) + " s poradovm slom " + std::to_string(sortNumber) + " nie je v hierarchii!");
     }
+    return node;
 }
 
 template<typename ISType>
-void HierarchySVK<ISType>::whereDoIGo(ds::amt::MultiWayExplicitHierarchy<Unit*>& hierarchy, ds::amt::MWEHBlock<Unit*>*& currBlock, size_t& i)
+void HierarchySVK<ISType>::whereDoIGo(const FlatHierarchy<Unit*>& hierarchy, size_t& currNode, size_t& i)
 {
     std::string nodeInput;
-    std::cout << "Zadajte index vrchola: ";
+    std::cout << "Zadajte index vrchola alebo adresu [@kd / #typ:poradov slo]: ";
     std::getline(std::cin, nodeInput);
 
-    while (std::stoi(nodeInput) < 0 || (std::stoi(nodeInput) == 0 && hierarchy.isRoot(*currBlock)) || std::stoi(nodeInput) >= i)
+    if (!nodeInput.empty() && (nodeInput.front() == '@' || nodeInput.front() == '#'))
+    {
+        // priamy presun cez index vrcholov, neznama adresa skonci vynimkou a volba sa zopakuje
+        currNode = this->accessNode(nodeInput);
+        return;
+    }
+
+    while (std::stoi(nodeInput) < 0 || (std::stoi(nodeInput) == 0 && hierarchy.isRoot(currNode)) || std::stoi(nodeInput) >= i)
     {
         std::cout << "Index mimo rozsahu. Zadajte znova: ";
         std::getline(std::cin, nodeInput);
@@ -314,18 +428,18 @@ void HierarchySVK<ISType>::whereDoIGo(ds::amt::MultiWayExplicitHierarchy<Unit*>&
     if (std::stoi(nodeInput) == 0)
     {
         // presun na otca
-        IteratorWrapper().moveIter(hierarchy, currBlock, -1);
+        currNode = hierarchy.accessParent(currNode);
     }
     else
     {
         // prasun na (std::stoi(input) - 1)-ho syna
-        IteratorWrapper().moveIter(hierarchy, currBlock, std::stoi(nodeInput) - 1);
+        currNode = hierarchy.accessSon(currNode, std::stoi(nodeInput) - 1);
     }
 }
 
 template <typename ISType>
 HierarchySVK<ISType>::~HierarchySVK()
 {
-    delete hierarchy.accessRoot()->data_;
-    hierarchy.clear();	// pridane
+    IS.unregisterIndex(kindergartens);
+    hierarchy.clear();	// pridane, jednotky (aj koren) patria UnitStore
 }
\ No newline at end of file
@@ -1,55 +1,177 @@
 #pragma once
 #include <libds/amt/implicit_sequence.h>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
 #include "Unit.h"
 #include "DataIO.h"
-#include "Algorithm.h"
+#include "WorkerPool.h"
+#include "Snapshot.h"
+#include "UnitStore.h"
+#include "UnitColumns.h"
+#include "TrigramIndex.h"
+#include "PrefixIndex.h"
+#include "KindergartenIndex.h"
+#include "QueryCache.h"
+#include "ResultCursor.h"
 
 class ImplicitSequences
 {
 public:
     ImplicitSequences();
-    ~ImplicitSequences();
     void findAndProcessUnit();
+    // jednotky typu unitType vyhovujuce operacii s parametrom (pri 'r' je to "a-b"), vytvaraju sa az pri prechode kurzorom
+    // 'Z' a 'O' su 'z' a 'o' bez ohladu na diakritiku a velkost pismen
+    ResultCursor findUnits(size_t unitType, char operation, const std::string& parameter);
     ds::amt::ImplicitSequence<Unit*>& getRegions() { return regions; };
     ds::amt::ImplicitSequence<Unit*>& getDistricts() { return districts; };
     ds::amt::ImplicitSequence<Unit*>& getMunicipalities() { return municipalities; };
+    WorkerPool& getWorkers() { return workers; };
+    UnitStore& getStore() { return store; };
+    QueryCache& getCache() { return cache; };
+    // indexy podla poctu materskych skol drzia kopiu poctu v stlpcoch => pocet sa meni len tu: presunie riadok jednotky
+    // vo vlastnych indexoch aj v prihlasenych (hierarchia), zmeni jednotku a zahodi ulozene vysledky dotazov
+    void setKindergartenNum(Unit* unit, size_t kindergartenNum);
+    // index nad vlastnymi stlpcami tych istych jednotiek; pred zanikom ho treba odhlasit
+    void registerIndex(KindergartenIndex& index);
+    void unregisterIndex(KindergartenIndex& index);
 
 private:
+    void loadUnits();
+    void buildColumns();
+
+private:
+    WorkerPool workers{};
+    UnitStore store{};                                  // vlastni vsetky jednotky, sekvencie drzia iba smerniky
     ds::amt::ImplicitSequence<Unit*> regions{};
     ds::amt::ImplicitSequence<Unit*> districts{};
     ds::amt::ImplicitSequence<Unit*> municipalities{};
+    UnitColumns regionColumns{};                        // tie iste jednotky ulozene po stlpcoch, filtre prehladavaju tieto
+    UnitColumns districtColumns{};
+    UnitColumns municipalityColumns{};
+    TrigramIndex regionTrigrams{};                      // indexy nad nazvami pre vyhladavanie "obsahuje"
+    TrigramIndex districtTrigrams{};
+    TrigramIndex municipalityTrigrams{};
+    PrefixIndex regionPrefixes{};                       // indexy nad nazvami pre vyhladavanie "zacina"
+    PrefixIndex districtPrefixes{};
+    PrefixIndex municipalityPrefixes{};
+    KindergartenIndex regionKindergartens{};            // indexy nad poctom materskych skol pre prahove dotazy
+    KindergartenIndex districtKindergartens{};
+    KindergartenIndex municipalityKindergartens{};
+    std::vector<KindergartenIndex*> registeredKindergartens{};  // indexy ostatnych urovni, menia sa spolu s vlastnymi
+    QueryCache cache{};                                 // vysledky opakovanych dotazov vsetkych urovni
 };
 
 ImplicitSequences::ImplicitSequences()
 {
+    this->loadUnits();
+    this->buildColumns();
+}
+
+void ImplicitSequences::loadUnits()
+{
+    // ulozene vysledky ukazuju na jednotky z predchadzajuceho nacitania
+    cache.clear();
+
+    // CSV subory su zdrojom pravdy; binarny obraz sa pouzije, len ak je novsi ako vsetky z nich
+    UnitSnapshot snapshot{ "jednotky.snap" };
+    if (snapshot.isNewerThan({ "kraje.csv", "kraje_extra.csv", "okresy.csv", "okresy_extra.csv", "obce.csv", "obce_extra.csv" }))
+    {
+        try
+        {
+            snapshot.read({ &regions, &districts, &municipalities }, store);
+            return;
+        }
+        catch (std::exception&)
+        {
+            // poskodeny alebo stary obraz => nacita sa z CSV a obraz sa prepise
+        }
+    }
+
     try
     {
-        DataIO<Unit>().dataInput("kraje", [&](Unit* unit) { regions.insertLast().data_ = unit; });
-        DataIO<Unit>().dataInput("okresy", [&](Unit* unit) { districts.insertLast().data_ = unit; });
-        DataIO<Unit>().dataInput("obce", [&](Unit* unit) { municipalities.insertLast().data_ = unit; });
+        DataIO<Unit>(store).dataInput("kraje", [&](Unit* unit) { regions.insertLast().data_ = unit; });
+        DataIO<Unit>(store).dataInput("okresy", [&](Unit* unit) { districts.insertLast().data_ = unit; });
+
+        // rovnomenne obce su v obce_extra.csv rozlisene nazvom okresu, okres sa najde podla zaciatku kodu obce
+        std::unordered_map<std::string_view, std::string_view> districtTitles{};
+        for (Unit* district : districts)
+        {
+            districtTitles.emplace(district->getCode(), district->getMediumTitle());
+        }
+
+        DataIO<Unit> municipalitiesIO{ store };
+        municipalitiesIO.setTitleQualifier([&districtTitles](std::string_view code) -> std::string
+            {
+                auto district = districtTitles.find(code.substr(0, 6));
+                return district != districtTitles.end() ? ", okres " + std::string(district->second) : std::string{};
+            });
+        municipalitiesIO.dataInputParallel("obce", municipalities, workers);    // najvacsi subor sa spracuje paralelne
     }
     catch (std::exception& ex)
     {
         std::cout << ex.what();
+        return;
+    }
+
+    try
+    {
+        snapshot.write({ &regions, &districts, &municipalities });
+    }
+    catch (std::exception&)
+    {
+        // obraz sa nepodarilo zapisat, pri dalsom spusteni sa znova nacita z CSV
     }
 }
 
-ImplicitSequences::~ImplicitSequences()
+void ImplicitSequences::buildColumns()
 {
-    for (auto unit : regions)
+    std::tuple<ds::amt::ImplicitSequence<Unit*>*, UnitColumns*, TrigramIndex*, PrefixIndex*, KindergartenIndex*> types[] = {
+        { &regions, &regionColumns, &regionTrigrams, &regionPrefixes, &regionKindergartens },
+        { &districts, &districtColumns, &districtTrigrams, &districtPrefixes, &districtKindergartens },
+        { &municipalities, &municipalityColumns, &municipalityTrigrams, &municipalityPrefixes, &municipalityKindergartens }
+    };
+    for (auto [units, columns, trigrams, prefixes, kindergartens] : types)
     {
-        delete unit;
+        columns->reserve(units->size());
+        for (Unit* unit : *units)
+        {
+            columns->insertLast(unit);
+        }
+        trigrams->build(*columns);
+        prefixes->build(*columns);
+        kindergartens->build(*columns);
     }
+}
 
-    for (auto unit : districts)
+void ImplicitSequences::setKindergartenNum(Unit* unit, size_t kindergartenNum)
+{
+    // indexy sa presuvaju podla stareho poctu v stlpci, jednotka sa zmeni az po nich; index bez jednotky ju preskoci
+    for (KindergartenIndex* index : { &regionKindergartens, &districtKindergartens, &municipalityKindergartens })
     {
-        delete unit;
+        index->update(unit, kindergartenNum);
     }
+    for (KindergartenIndex* index : this->registeredKindergartens)
+    {
+        index->update(unit, kindergartenNum);
+    }
+    unit->setKindergartenNum(kindergartenNum);
+    this->cache.clear();
+}
 
-    for (auto unit : municipalities)
+void ImplicitSequences::registerIndex(KindergartenIndex& index)
+{
+    if (std::find(this->registeredKindergartens.begin(), this->registeredKindergartens.end(), &index) != this->registeredKindergartens.end())
     {
-        delete unit;
+        throw std::invalid_argument("Index je u prihlsen!");
     }
+    this->registeredKindergartens.push_back(&index);
+}
+
+void ImplicitSequences::unregisterIndex(KindergartenIndex& index)
+{
+    this->registeredKindergartens.erase(std::remove(this->registeredKindergartens.begin(), this->registeredKindergartens.end(), &index), this->registeredKindergartens.end());
 }
 
 void ImplicitSequences::findAndProcessUnit()
@@ -62,61 +184,41 @@ void ImplicitSequences::findAndProcessUnit()
         size_t unitType{};
         InputCheck().checkInput(unitType, "Typ zemnej jednotky: kraje [1] | okresy [2] | obce [3]: ", "Nesprvny vstup. Zadajte znova: ", [&unitType]() -> bool { return unitType != 1 && unitType != 2 && unitType != 3; });
 
-        ds::amt::ImplicitSequence<Unit*>& data{ unitType == 1 ? regions : unitType == 2 ? districts : municipalities };
-
         // vyber operacie
         char operation{};
-        InputCheck().checkInput(operation, "Opercia: zana [z] | obsahuje [o] | m aspo n materskch kl [m]: ", "Nesprvny vstup. Zadajte znova: ", [&operation]() -> bool { return operation != 'z' && operation != 'o' && operation != 'm'; });
+        InputCheck().checkInput(operation, "Opercia: zana [z] | obsahuje [o] | zana / obsahuje bez diakritiky [Z / O] | m aspo n materskch kl [m] | poet materskch kl od a do b [r] | k jednotiek s najviac materskmi kolami [k]: ", "Nesprvny vstup. Zadajte znova: ",
+            [&operation]() -> bool { return operation != 'z' && operation != 'o' && operation != 'Z' && operation != 'O' && operation != 'm' && operation != 'r' && operation != 'k'; });
 
-        std::string searchedStr{};
-        size_t kindergartenNum{};
-
-        ds::amt::ImplicitSequence<Unit*> processedData{};
-        std::function<void(Unit* insertedUnit)> insert = [&](Unit* insertedUnit) { processedData.insertLast().data_ = insertedUnit; };
-
-        Algorithm<Unit*, ds::amt::ImplicitSequence<Unit*>::ImplicitSequenceIterator> a;
-
-        if (operation == 'z' || operation == 'o')
+        // vyber parametra
+        std::string parameter{};
+        std::string numInput{};
+        if (operation == 'z' || operation == 'o' || operation == 'Z' || operation == 'O')
         {
-            // vyber substringu
             std::cout << "Zadajte hadan substring: ";
-            std::getline(std::cin, searchedStr);
-
-            std::function<bool(Unit* testedUnit)> containsStr = [&](Unit* testedUnit) { return (*testedUnit).containsStr(searchedStr); };
-            std::function<bool(Unit* testedUnit)> startsWithStr = [&](Unit* testedUnit) { return (*testedUnit).startsWithStr(searchedStr); };
-
-            if (operation == 'z')
-            {
-                a.findAndProcess(data.begin(), data.end(),
-                    startsWithStr,  // predicate
-                    insert);        // process
-            }
-            else
-            {
-                a.findAndProcess(data.begin(), data.end(),
-                    containsStr,    // predicate
-                    insert);        // process
-            }
+            std::getline(std::cin, parameter);
+        }
+        else if (operation == 'k')
+        {
+            std::cout << "Zadajte poet jednotiek: ";
+            std::getline(std::cin, numInput);
+            parameter = std::to_string(static_cast<size_t>(std::stoi(numInput)));
         }
         else
         {
-            std::string numInput;
             std::cout << "Zadajte minimlny poet materskch kl: ";
             std::getline(std::cin, numInput);
-            kindergartenNum = std::stoi(numInput);
-
-            std::function<bool(Unit* testedUnit)> atLeastNKindergartens = [&](Unit* testedUnit) { return (*testedUnit).getKindergartenNum() >= kindergartenNum; };
-
-            a.findAndProcess(data.begin(), data.end(),
-                atLeastNKindergartens,
-                insert);
+            parameter = std::to_string(static_cast<size_t>(std::stoi(numInput)));
+            if (operation == 'r')
+            {
+                std::cout << "Zadajte maximlny poet materskch kl: ";
+                std::getline(std::cin, numInput);
+                parameter += '-' + std::to_string(static_cast<size_t>(std::stoi(numInput)));
+            }
         }
 
+        // jednotky sa vypisuju priamo pri hladani, bez kopirovania do sekvencie
         std::cout << "Njden dta:\n";
-        for (auto unit : processedData)
-        {
-            std::cout << "\t" << *unit << "\n";
-        }
+        this->findUnits(unitType, operation, parameter).forEach([](Unit* unit) { std::cout << "\t" << *unit << "\n"; });
 
         // vyber pokracovania
         InputCheck().checkInput(cont, "Pokraova? [0/1]: ", "Nesprvny vstup. Zadajte znova: ", [&cont]() -> bool { return cont != 0 && cont != 1; });
@@ -124,4 +226,45 @@ void ImplicitSequences::findAndProcessUnit()
     }
 
     std::cout << "=== KONIEC ROVNE 1 ===\n\n";
+}
+
+ResultCursor ImplicitSequences::findUnits(size_t unitType, char operation, const std::string& parameter)
+{
+    if (unitType < 1 || unitType > 3)
+    {
+        throw std::invalid_argument("Neznmy typ zemnej jednotky!");
+    }
+
+    UnitColumns* data{ unitType == 1 ? &regionColumns : unitType == 2 ? &districtColumns : &municipalityColumns };
+    TrigramIndex* trigrams{ unitType == 1 ? &regionTrigrams : unitType == 2 ? &districtTrigrams : &municipalityTrigrams };
+    PrefixIndex* prefixes{ unitType == 1 ? &regionPrefixes : unitType == 2 ? &districtPrefixes : &municipalityPrefixes };
+    KindergartenIndex* kindergartens{ unitType == 1 ? &regionKindergartens : unitType == 2 ? &districtKindergartens : &municipalityKindergartens };
+
+    // opakovany dotaz sa vezme z vyrovnavacej pamate
+    return ResultCursor::cached(cache, { data, operation, parameter }, [=](const ResultCursor::Yield& yield)
+        {
+            auto insert = [&](UnitRow& insertedRow) { return yield(insertedRow.getUnit()); };
+            switch (operation)
+            {
+            case 'z':
+            case 'Z':
+                prefixes->findStartingWith(parameter, operation == 'Z' ? FOLDED_MATCH : EXACT_MATCH, 0, data->size(), insert);
+                break;
+            case 'o':
+            case 'O':
+                trigrams->findContaining(parameter, operation == 'O' ? FOLDED_MATCH : EXACT_MATCH, 0, data->size(), insert);
+                break;
+            case 'k':
+                kindergartens->findTop(std::stoull(parameter), 0, data->size(), insert);
+                break;
+            case 'm':
+                kindergartens->findAtLeast(std::stoull(parameter), 0, data->size(), insert);
+                break;
+            case 'r':
+                kindergartens->findBetween(std::stoull(parameter), std::stoull(parameter.substr(parameter.find('-') + 1)), 0, data->size(), insert);
+                break;
+            default:
+                throw std::invalid_argument("Neznma opercia!");
+            }
+        });
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <cstdint>
+#include "UnitColumns.h"
+
+// riadky zoradene podla poctu materskych skol (pri rovnosti podla riadku) => jednotky s poctom v rozsahu tvoria suvisly usek
+class KindergartenIndex
+{
+public:
+    void build(UnitColumns& columns);
+
+    // spracuje riadky z [firstRow, endRow) s poctom materskych skol >= minimum, vo vzostupnom poradi riadkov; ak process vrati false, skonci
+    void findAtLeast(size_t minimum, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const;
+    // to iste pre pocet v rozsahu [minimum, maximum]
+    void findBetween(size_t minimum, size_t maximum, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const;
+    // count riadkov z [firstRow, endRow) s najvacsim poctom, zostupne podla poctu (pri rovnosti podla riadku)
+    void findTop(size_t count, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const;
+
+    // ak je jednotka v stlpcoch indexu, zmeni jej pocet materskych skol v stlpci a presunie riadok na nove miesto v usporiadani
+    // vola sa z ImplicitSequences::setKindergartenNum pre vsetky indexy naraz, samotnu jednotku meni az on
+    void update(const Unit* unit, size_t kindergartenNum);
+
+private:
+    size_t kindergartenNum(uint32_t row) const { return this->columns->access(row).getKindergartenNum(); };
+    bool less(uint32_t row1, uint32_t row2) const;
+
+private:
+    UnitColumns* columns{ nullptr };
+    std::vector<uint32_t> sortedRows{};
+};
+
+bool KindergartenIndex::less(uint32_t row1, uint32_t row2) const
+{
+    size_t count1 = this->kindergartenNum(row1);
+    size_t count2 = this->kindergartenNum(row2);
+    return count1 < count2 || (count1 == count2 && row1 < row2);
+}
+
+void KindergartenIndex::build(UnitColumns& columns)
+{
+    this->columns = &columns;
+    this->sortedRows.resize(columns.size());
+    for (size_t row = 0; row < columns.size(); ++row)
+    {
+        this->sortedRows[row] = static_cast<uint32_t>(row);
+    }
+
+    std::sort(this->sortedRows.begin(), this->sortedRows.end(), [this](uint32_t row1, uint32_t row2) { return this->less(row1, row2); });
+}
+
+void KindergartenIndex::findAtLeast(size_t minimum, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const
+{
+    this->findBetween(minimum, (std::numeric_limits<size_t>::max)(), firstRow, endRow, process);
+}
+
+void KindergartenIndex::findBetween(size_t minimum, size_t maximum, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const
+{
+    endRow = (std::min)(endRow, this->columns->size());
+    if (minimum > maximum)
+    {
+        return;
+    }
+
+    auto first = std::lower_bound(this->sortedRows.begin(), this->sortedRows.end(), minimum,
+        [this](uint32_t row, size_t count) { return this->kindergartenNum(row) < count; });
+    auto last = std::upper_bound(first, this->sortedRows.end(), maximum,
+        [this](size_t count, uint32_t row) { return count < this->kindergartenNum(row); });
+
+    // ak je zhod viac nez riadkov v useku (podstrom), je lacnejsie usek priamo prejst
+    if (static_cast<size_t>(last - first) > endRow - firstRow)
+    {
+        for (size_t row = firstRow; row < endRow; ++row)
+        {
+            UnitRow unitRow{ this->columns->access(row) };
+            size_t count = unitRow.getKindergartenNum();
+            if (count >= minimum && count <= maximum && !process(unitRow))
+            {
+                return;
+            }
+        }
+        return;
+    }
+
+    // vysledky sa vypisuju v poradi riadkov, rovnako ako pri prehliadke
+    std::vector<uint32_t> found{};
+    for (auto position = first; position != last; ++position)
+    {
+        if (*position >= firstRow && *position < endRow)
+        {
+            found.push_back(*position);
+        }
+    }
+    std::sort(found.begin(), found.end());
+
+    for (uint32_t row : found)
+    {
+        UnitRow unitRow{ this->columns->access(row) };
+        if (!process(unitRow))
+        {
+            return;
+        }
+    }
+}
+
+void KindergartenIndex::findTop(size_t count, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const
+{
+    endRow = (std::min)(endRow, this->columns->size());
+    size_t rowCount = endRow - firstRow;
+    count = (std::min)(count, rowCount);
+
+    std::vector<uint32_t> found{};
+    found.reserve(count);
+    if (count * this->sortedRows.size() > rowCount * rowCount)
+    {
+        // maly usek (podstrom) => ocakavane prejdenie indexu by bolo dlhsie nez usek, vyberie sa priamo z neho
+        for (size_t row = firstRow; row < endRow; ++row)
+        {
+            found.push_back(static_cast<uint32_t>(row));
+        }
+        std::partial_sort(found.begin(), found.begin() + count, found.end(), [this](uint32_t row1, uint32_t row2)
+            {
+                size_t count1 = this->kindergartenNum(row1);
+                size_t count2 = this->kindergartenNum(row2);
+                return count1 > count2 || (count1 == count2 && row1 < row2);
+            });
+        found.resize(count);
+    }
+    else
+    {
+        // od konca po skupinach s rovnakym poctom, v skupine vzostupne podla riadku
+        auto groupEnd = this->sortedRows.end();
+        while (found.size() < count && groupEnd != this->sortedRows.begin())
+        {
+            size_t groupCount = this->kindergartenNum(*(groupEnd - 1));
+            auto groupBegin = std::lower_bound(this->sortedRows.begin(), groupEnd, groupCount,
+                [this](uint32_t row, size_t value) { return this->kindergartenNum(row) < value; });
+            for (auto position = groupBegin; position != groupEnd && found.size() < count; ++position)
+            {
+                if (*position >= firstRow && *position < endRow)
+                {
+                    found.push_back(*position);
+                }
+            }
+            groupEnd = groupBegin;
+        }
+    }
+
+    for (uint32_t row : found)
+    {
+        UnitRow unitRow{ this->columns->access(row) };
+        if (!process(unitRow))
+        {
+            return;
+        }
+    }
+}
+
+void KindergartenIndex::update(const Unit* unit, size_t kindergartenNum)
+{
+    size_t row = this->columns->findRow(unit);
+    if (row == UnitColumns::NONE)
+    {
+        return;
+    }
+
+    uint32_t updatedRow = static_cast<uint32_t>(row);
+    auto position = std::lower_bound(this->sortedRows.begin(), this->sortedRows.end(), updatedRow, [this](uint32_t row1, uint32_t row2) { return this->less(row1, row2); });
+    this->sortedRows.erase(position);
+
+    this->columns->setKindergartenNum(row, kindergartenNum);
+    position = std::lower_bound(this->sortedRows.begin(), this->sortedRows.end(), updatedRow, [this](uint32_t row1, uint32_t row2) { return this->less(row1, row2); });
+    this->sortedRows.insert(position, updatedRow);
+}
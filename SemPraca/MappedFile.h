@@ -0,0 +1,121 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// subor namapovany do pamate iba na citanie; obsah je dostupny ako jeden string_view bez kopirovania
+class MappedFile
+{
+public:
+    MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view getContent() const { return std::string_view(this->data, this->size); };
+
+private:
+    const char* data{ nullptr };
+    size_t size{ 0 };
+
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE file{ INVALID_HANDLE_VALUE };
+    HANDLE mapping{ nullptr };
+#else
+    int file{ -1 };
+#endif
+};
+
+#if defined(_WIN32) || defined(_WIN64)
+
+MappedFile::MappedFile(const std::string& path)
+{
+    this->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (this->file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Chyba pri tan zo sboru!");
+    }
+
+    LARGE_INTEGER fileSize{};
+    GetFileSizeEx(this->file, &fileSize);
+    this->size = static_cast<size_t>(fileSize.QuadPart);
+
+    if (this->size > 0)                             // prazdny subor sa namapovat neda
+    {
+        this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        this->data = this->mapping != nullptr ? static_cast<const char*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        if (this->data == nullptr)
+        {
+            if (this->mapping != nullptr)
+            {
+                CloseHandle(this->mapping);
+            }
+            CloseHandle(this->file);
+            throw std::runtime_error("Chyba pri tan zo sboru!");
+        }
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (this->data != nullptr)
+    {
+        UnmapViewOfFile(this->data);
+    }
+    if (this->mapping != nullptr)
+    {
+        CloseHandle(this->mapping);
+    }
+    CloseHandle(this->file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+{
+    this->file = open(path.c_str(), O_RDONLY);
+    struct stat fileStat{};
+    if (this->file < 0 || fstat(this->file, &fileStat) != 0)
+    {
+        if (this->file >= 0)
+        {
+            close(this->file);
+        }
+        throw std::runtime_error("Chyba pri tan zo sboru!");
+    }
+
+    this->size = static_cast<size_t>(fileStat.st_size);
+
+    if (this->size > 0)
+    {
+        void* mapped = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, this->file, 0);
+        if (mapped == MAP_FAILED)
+        {
+            close(this->file);
+            throw std::runtime_error("Chyba pri tan zo sboru!");
+        }
+        madvise(mapped, this->size, MADV_SEQUENTIAL);
+        this->data = static_cast<const char*>(mapped);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (this->data != nullptr)
+    {
+        munmap(const_cast<char*>(this->data), this->size);
+    }
+    close(this->file);
+}
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+#include <unordered_map>
+#include <string_view>
+#include <cstdint>
+#include "Unit.h"
+#include "FlatHierarchy.h"
+
+// hashovaci index vrcholov zmrazenej hierarchie podla kodu jednotky a podla (typ, poradove cislo) => presun na vrchol v O(1)
+// poradove cisla sa opakuju v roznych urovniach, preto su v kluci spolu s typom
+// kod nie je jednoznacny (okresy Zahranicie), plati prvy vrchol v pre-order
+class NodeIndex
+{
+public:
+    static constexpr size_t NONE = FlatHierarchy<Unit*>::NONE;
+
+    void build(const FlatHierarchy<Unit*>& hierarchy);
+
+    size_t findByCode(std::string_view code) const;
+    size_t findBySortNumber(size_t type, size_t sortNumber) const;
+
+private:
+    static uint64_t sortKey(size_t type, size_t sortNumber) { return static_cast<uint64_t>(type) << 32 | sortNumber; };
+
+private:
+    std::unordered_map<std::string_view, uint32_t> byCode{};            // kody ukazuju do UnitStore, jednotky sa pocas behu nepresuvaju
+    std::unordered_map<uint64_t, uint32_t> bySortNumber{};
+};
+
+void NodeIndex::build(const FlatHierarchy<Unit*>& hierarchy)
+{
+    this->byCode.clear();
+    this->bySortNumber.clear();
+    this->byCode.reserve(hierarchy.size());
+    this->bySortNumber.reserve(hierarchy.size());
+    for (size_t node = 0; node < hierarchy.size(); ++node)
+    {
+        const Unit& unit = *hierarchy.access(node);
+        // emplace necha prvy vlozeny vrchol
+        this->byCode.emplace(unit.getCode(), static_cast<uint32_t>(node));
+        this->bySortNumber.emplace(sortKey(unit.getType(), unit.getSortNumber()), static_cast<uint32_t>(node));
+    }
+}
+
+size_t NodeIndex::findByCode(std::string_view code) const
+{
+    auto found = this->byCode.find(code);
+    return found == this->byCode.end() ? NONE : found->second;
+}
+
+size_t NodeIndex::findBySortNumber(size_t type, size_t sortNumber) const
+{
+    auto found = this->bySortNumber.find(sortKey(type, sortNumber));
+    return found == this->bySortNumber.end() ? NONE : found->second;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "UnitColumns.h"
+#include "TitleScan.h"
+#include "Cp1250.h"
+
+// riadky zoradene podla zlozeneho nazvu => vsetky nazvy s tou istou zlozenou predponou tvoria suvisly usek
+// porovnava sa po bajtoch (ako string_view::compare), teda rovnako ako rfind(searched, 0) == 0
+// presne zhody su podmnozinou useku zlozenej predpony => pri EXACT_MATCH sa usek este preosieva
+class PrefixIndex
+{
+public:
+    void build(const UnitColumns& columns);
+
+    // spracuje riadky z [firstRow, endRow), ktorych nazov zacina na searched, vo vzostupnom poradi riadkov; ak process vrati false, skonci
+    void findStartingWith(const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const;
+
+private:
+    std::string_view title(uint32_t row) const { return this->columns->access(row).getFoldedTitle(); };
+
+private:
+    const UnitColumns* columns{ nullptr };
+    std::vector<uint32_t> sortedRows{};
+};
+
+void PrefixIndex::build(const UnitColumns& columns)
+{
+    this->columns = &columns;
+    this->sortedRows.resize(columns.size());
+    for (size_t row = 0; row < columns.size(); ++row)
+    {
+        this->sortedRows[row] = static_cast<uint32_t>(row);
+    }
+
+    std::sort(this->sortedRows.begin(), this->sortedRows.end(), [this](uint32_t row1, uint32_t row2)
+        {
+            int order = this->title(row1).compare(this->title(row2));
+            return order < 0 || (order == 0 && row1 < row2);
+        });
+}
+
+void PrefixIndex::findStartingWith(const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const
+{
+    const std::string folded{ Cp1250::fold(searched) };
+    const std::string& compared{ match == FOLDED_MATCH ? folded : searched };
+    std::string_view prefix{ folded };
+    endRow = (std::min)(endRow, this->columns->size());
+
+    // usek nazvov, ktorych prvych prefix.size() bajtov sa rovna predpone
+    auto first = std::lower_bound(this->sortedRows.begin(), this->sortedRows.end(), prefix,
+        [this](uint32_t row, std::string_view key) { return this->title(row).substr(0, key.size()) < key; });
+    auto last = std::upper_bound(first, this->sortedRows.end(), prefix,
+        [this](std::string_view key, uint32_t row) { return key < this->title(row).substr(0, key.size()); });
+
+    // pri sirokej predpone a malom useku (podstrom) je lacnejsie usek priamo prehladat, nez triedit vsetky zhody
+    if (static_cast<size_t>(last - first) > endRow - firstRow)
+    {
+        TitleScan::findStartingWith(*this->columns, compared, match, firstRow, endRow, process);
+        return;
+    }
+
+    // vysledky sa vypisuju v poradi riadkov, rovnako ako pri prehliadke
+    std::vector<uint32_t> found{};
+    for (auto position = first; position != last; ++position)
+    {
+        if (*position >= firstRow && *position < endRow && (match == FOLDED_MATCH || this->columns->access(*position).startsWithStr(searched)))
+        {
+            found.push_back(*position);
+        }
+    }
+    std::sort(found.begin(), found.end());
+
+    for (uint32_t row : found)
+    {
+        UnitRow unitRow{ this->columns->access(row) };
+        if (!process(unitRow))
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <list>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include "Unit.h"
+
+// dotaz = rozsah (sekvencia jedneho typu, vrchol hierarchie, tabulka), operacia a jej parameter
+struct QueryKey
+{
+    const void* scope;
+    char operation;
+    std::string parameter;
+
+    bool operator==(const QueryKey& other) const { return this->scope == other.scope && this->operation == other.operation && this->parameter == other.parameter; };
+};
+
+struct QueryKeyHash
+{
+    size_t operator()(const QueryKey& key) const
+    {
+        size_t hash = std::hash<const void*>()(key.scope) ^ (std::hash<std::string>()(key.parameter) << 1);
+        return hash ^ (static_cast<size_t>(key.operation) << 3);
+    }
+};
+
+// ohranicena vyrovnavacia pamat vysledkov dotazov, pri zaplneni sa zahodi najdlhsie nepouzity (LRU)
+// vysledok je zoznam smernikov na jednotky v UnitStore => pri novom nacitani dat sa musi vyprazdnit (clear)
+class QueryCache
+{
+public:
+    QueryCache(size_t capacity = DEFAULT_CAPACITY) : capacity(capacity) {};
+
+    // vysledok dotazu z pamate, inak ho vypocita query (naplni vektor) a ulozi; referencia plati do dalsieho volania
+    template <typename QueryType>
+    const std::vector<Unit*>& findOrRun(const QueryKey& key, QueryType query);
+    // ulozeny vysledok (alebo nullptr) a jeho ulozenie zvlast, napr. pre postupne vytvarane vysledky
+    const std::vector<Unit*>* find(const QueryKey& key);
+    const std::vector<Unit*>& insert(const QueryKey& key, std::vector<Unit*> result);
+    void clear();
+
+    size_t size() const { return this->positions.size(); };
+    size_t getCapacity() const { return this->capacity; };
+    size_t getHits() const { return this->hits; };
+    size_t getMisses() const { return this->misses; };
+
+private:
+    using Entry = std::pair<QueryKey, std::vector<Unit*>>;
+
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    size_t capacity;
+    std::list<Entry> entries{};                         // od naposledy pouziteho po najdlhsie nepouzity
+    std::unordered_map<QueryKey, std::list<Entry>::iterator, QueryKeyHash> positions{};
+    size_t hits{ 0 };
+    size_t misses{ 0 };
+};
+
+template <typename QueryType>
+const std::vector<Unit*>& QueryCache::findOrRun(const QueryKey& key, QueryType query)
+{
+    if (const std::vector<Unit*>* found = this->find(key))
+    {
+        return *found;
+    }
+
+    std::vector<Unit*> result{};
+    query(result);
+    return this->insert(key, std::move(result));
+}
+
+const std::vector<Unit*>* QueryCache::find(const QueryKey& key)
+{
+    auto position = this->positions.find(key);
+    if (position == this->positions.end())
+    {
+        ++this->misses;
+        return nullptr;
+    }
+
+    ++this->hits;
+    this->entries.splice(this->entries.begin(), this->entries, position->second);
+    return &position->second->second;
+}
+
+const std::vector<Unit*>& QueryCache::insert(const QueryKey& key, std::vector<Unit*> result)
+{
+    auto position = this->positions.find(key);
+    if (position != this->positions.end())
+    {
+        // ten isty dotaz prebehol znova, novsi vysledok nahradi stary
+        this->entries.erase(position->second);
+        this->positions.erase(position);
+    }
+
+    if (this->capacity == 0)
+    {
+        this->entries.clear();          // bez ulozenia, vysledok sa vrati cez jedinu docasnu polozku
+    }
+    else if (this->entries.size() == this->capacity)
+    {
+        this->positions.erase(this->entries.back().first);
+        this->entries.pop_back();
+    }
+
+    this->entries.emplace_front(key, std::move(result));
+    if (this->capacity > 0)
+    {
+        this->positions.emplace(key, this->entries.begin());
+    }
+    return this->entries.front().second;
+}
+
+void QueryCache::clear()
+{
+    this->entries.clear();
+    this->positions.clear();
+}
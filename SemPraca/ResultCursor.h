@@ -0,0 +1,90 @@
+#pragma once
+#include <libds/amt/implicit_sequence.h>
+#include <vector>
+#include <limits>
+#include <functional>
+#include "Unit.h"
+#include "QueryCache.h"
+
+// lenivy vysledok dotazu: zhody vytvara zdroj az pri prechode a posiela ich po jednej, prechod sa moze kedykolvek ukoncit
+// strankovanie cez offset / limit; do sekvencie sa vysledok skopiruje len pri triedeni (materialize)
+class ResultCursor
+{
+public:
+    using Yield = std::function<bool(Unit*)>;               // vrati false => zdroj ma skoncit
+    using Source = std::function<void(const Yield& yield)>;
+
+    ResultCursor(Source source) : source(std::move(source)) {};
+    // vysledok z vyrovnavacej pamate, inak zo zdroja; uplny prechod zdrojom sa do pamate ulozi, predcasne ukonceny nie
+    static ResultCursor cached(QueryCache& cache, const QueryKey& key, Source source);
+
+    ResultCursor& setOffset(size_t offset) { this->offset = offset; return *this; };
+    ResultCursor& setLimit(size_t limit) { this->limit = limit; return *this; };
+
+    // spracuje zhody [offset, offset + limit), po poslednej zdroj skonci; vrati pocet spracovanych
+    size_t forEach(const std::function<void(Unit*)>& process) const;
+    void materialize(ds::amt::ImplicitSequence<Unit*>& sequence) const;
+
+private:
+    Source source;
+    size_t offset{ 0 };
+    size_t limit{ (std::numeric_limits<size_t>::max)() };
+};
+
+ResultCursor ResultCursor::cached(QueryCache& cache, const QueryKey& key, Source source)
+{
+    return ResultCursor([&cache, key, source](const Yield& yield)
+        {
+            if (const std::vector<Unit*>* found = cache.find(key))
+            {
+                for (Unit* unit : *found)
+                {
+                    if (!yield(unit))
+                    {
+                        return;
+                    }
+                }
+                return;
+            }
+
+            std::vector<Unit*> result{};
+            bool complete = true;
+            source([&](Unit* unit)
+                {
+                    result.push_back(unit);
+                    complete = yield(unit);
+                    return complete;
+                });
+            if (complete)
+            {
+                cache.insert(key, std::move(result));
+            }
+        });
+}
+
+size_t ResultCursor::forEach(const std::function<void(Unit*)>& process) const
+{
+    size_t skipped{ 0 };
+    size_t processed{ 0 };
+    if (this->limit == 0)
+    {
+        return processed;
+    }
+
+    this->source([&](Unit* unit)
+        {
+            if (skipped < this->offset)
+            {
+                ++skipped;
+                return true;
+            }
+            process(unit);
+            return ++processed < this->limit;
+        });
+    return processed;
+}
+
+void ResultCursor::materialize(ds::amt::ImplicitSequence<Unit*>& sequence) const
+{
+    this->forEach([&sequence](Unit* unit) { sequence.insertLast().data_ = unit; });
+}
@@ -5,8 +5,10 @@
 #include "HierarchySVK.h"
 #include "Tables.h"
 #include "Sort.h"
+#include "Benchmark.h"
+#include "BatchQueries.h"
 
-int main()
+int main(int argc, char* argv[])
 {
 	initHeapMonitor();
 	SetConsoleOutputCP(1250);
@@ -14,39 +16,72 @@ int main()
 
 	ImplicitSequences IS = ImplicitSequences();
 
+	if (argc > 1 && std::string(argv[1]) == "--benchmark")
+	{
+		Benchmark(IS).run();
+		return 0;
+	}
+
 	ds::amt::ImplicitSequence<Unit*> regions{ IS.getRegions() };
 	ds::amt::ImplicitSequence<Unit*> districts{ IS.getDistricts() };
 	ds::amt::ImplicitSequence<Unit*> municipalities{ IS.getMunicipalities() };
 
-	HierarchySVK hierarchySVK = HierarchySVK<ds::amt::ImplicitSequence<Unit*>>(regions, districts, municipalities);
+	HierarchySVK hierarchySVK = HierarchySVK<ds::amt::ImplicitSequence<Unit*>>(IS, regions, districts, municipalities);
 
-	Tables tables = Tables<Unit, ds::amt::ImplicitSequence<Unit*>>(regions, districts, municipalities);
+	Tables tables = Tables<Unit, ds::amt::ImplicitSequence<Unit*>>(IS.getCache(), regions, districts, municipalities);
 
-	size_t cont{ 1 };
-	while (cont)
+	if (argc > 1 && std::string(argv[1]) == "--batch")
 	{
-		size_t level;
-		InputCheck().checkInput(level, "Vyberte rove: sekvencie [1] | hierarchia + triedenia [2/4] | tabuky [3]: ", "Nevhodn vstup. Zadajte znova: ",
-			[&level]() -> bool { return level != 1 && level != 2 && level != 3 && level != 4; });
-
-		switch (level)
+		// dotazy zo suboru (druhy argument) alebo zo standardneho vstupu, vysledky na standardny vystup
+		BatchQueries<ds::amt::ImplicitSequence<Unit*>> batch{ IS, hierarchySVK, tables };
+		if (argc > 2)
+		{
+			std::ifstream queries{ argv[2] };
+			if (!queries)
+			{
+				std::cout << "Chyba pri tan zo sboru!\n";
+				return 1;
+			}
+			batch.run(queries, std::cout);
+		}
+		else
+		{
+			batch.run(std::cin, std::cout);
+		}
+	}
+	else
+	{
+		size_t cont{ 1 };
+		while (cont)
 		{
-		case 1:
-			IS.findAndProcessUnit();					// 1. uroven
-			break;
-
-		case 2:
-		case 4:
-			hierarchySVK.navigateHierarchy();			// 2. + 4. uroven
-			break;
-
-		case 3:
-			tables.displayUnitInfo();					// 3. uroven
-			break;
+			size_t level;
+			InputCheck().checkInput(level, "Vyberte rove: sekvencie [1] | hierarchia + triedenia [2/4] | tabuky [3]: ", "Nevhodn vstup. Zadajte znova: ",
+				[&level]() -> bool { return level != 1 && level != 2 && level != 3 && level != 4; });
+
+			switch (level)
+			{
+			case 1:
+				IS.findAndProcessUnit();					// 1. uroven
+				break;
+
+			case 2:
+			case 4:
+				hierarchySVK.navigateHierarchy();			// 2. + 4. uroven
+				break;
+
+			case 3:
+				tables.displayUnitInfo();					// 3. uroven
+				break;
+			}
+			InputCheck().checkInput(cont, "Chcete pokraova alou rovou? [0/1]: ", "Nevhodn vstup. Zadajte znova: ",
+				[&cont]() -> bool { return cont != 0 && cont != 1; });
 		}
-		InputCheck().checkInput(cont, "Chcete pokraova alou rovou? [0/1]: ", "Nevhodn vstup. Zadajte znova: ",
-			[&cont]() -> bool { return cont != 0 && cont != 1; });
 	}
 
+	// podla tychto cisel sa nastavuje velkost vyrovnavacej pamate dotazov
+	QueryCache& cache{ IS.getCache() };
+	std::cout << "Vyrovnvacia pam dotazov: " << cache.getHits() << " zsahov, " << cache.getMisses() << " vpadkov, "
+		<< cache.size() << " z " << cache.getCapacity() << " poloiek\n";
+
 	return 0;
 }
\ No newline at end of file
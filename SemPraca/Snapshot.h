@@ -0,0 +1,180 @@
+#pragma once
+#include <libds/amt/implicit_sequence.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <cstdint>
+#include "Unit.h"
+#include "UnitStore.h"
+#include "MappedFile.h"
+
+// binarny obraz nacitanych uzemnych jednotiek
+// format: hlavicka (MAGIC, VERSION, pocet sekcii), potom pre kazdu sekciu pocet jednotiek a jednotky za sebou:
+//     sortNumber (u64), kindergartenNum (u64), code, officialTitle, mediumTitle, shortTitle, note, altTitle (kazdy retazec: dlzka u32 + bajty)
+class UnitSnapshot
+{
+public:
+    UnitSnapshot(std::string path) : path(std::move(path)) {};
+
+    bool isNewerThan(const std::vector<std::string>& sources) const;
+    void write(const std::vector<ds::amt::ImplicitSequence<Unit*>*>& sections) const;
+    void read(const std::vector<ds::amt::ImplicitSequence<Unit*>*>& sections, UnitStore& store) const;
+
+private:
+    static constexpr char MAGIC[8] = { 'A', 'U', 'S', 'S', 'N', 'A', 'P', '\0' };
+    static const uint32_t VERSION = 1;
+
+    void writeNumber(std::string& buffer, uint64_t number) const;
+    void writeString(std::string& buffer, std::string_view str) const;
+    uint64_t readNumber(std::string_view& content, size_t size) const;
+    std::string_view readString(std::string_view& content) const;
+
+private:
+    std::string path;
+};
+
+bool UnitSnapshot::isNewerThan(const std::vector<std::string>& sources) const
+{
+    std::error_code error{};
+    auto snapshotTime = std::filesystem::last_write_time(this->path, error);
+    if (error)
+    {
+        return false;
+    }
+
+    for (const auto& source : sources)
+    {
+        auto sourceTime = std::filesystem::last_write_time(source, error);
+        if (error || sourceTime >= snapshotTime)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UnitSnapshot::write(const std::vector<ds::amt::ImplicitSequence<Unit*>*>& sections) const
+{
+    // cely obraz sa posklada v pamati a zapise naraz do docasneho suboru, ktory sa az potom premenuje
+    std::string buffer(MAGIC, sizeof(MAGIC));
+    this->writeNumber(buffer, VERSION);
+    this->writeNumber(buffer, sections.size());
+
+    for (auto section : sections)
+    {
+        this->writeNumber(buffer, section->size());
+        for (Unit* unit : *section)
+        {
+            this->writeNumber(buffer, unit->getSortNumber());
+            this->writeNumber(buffer, unit->getKindergartenNum());
+            this->writeString(buffer, unit->getCode());
+            this->writeString(buffer, unit->getOfficialTitle());
+            this->writeString(buffer, unit->getMediumTitle());
+            this->writeString(buffer, unit->getShortTitle());
+            this->writeString(buffer, unit->getNote());
+            this->writeString(buffer, unit->getAltTitle());
+        }
+    }
+
+    std::string tmpPath{ this->path + ".tmp" };
+    {
+        std::ofstream output{ tmpPath, std::ios::binary | std::ios::trunc };
+        if (!output || !output.write(buffer.data(), buffer.size()))
+        {
+            throw std::runtime_error("Chyba pri zpise do sboru!");
+        }
+    }
+    std::filesystem::rename(tmpPath, this->path);
+}
+
+void UnitSnapshot::read(const std::vector<ds::amt::ImplicitSequence<Unit*>*>& sections, UnitStore& store) const
+{
+    MappedFile input{ this->path };
+    std::string_view content{ input.getContent() };
+
+    if (content.size() < sizeof(MAGIC) || std::memcmp(content.data(), MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw std::runtime_error("Neplatn sbor s obrazom dt!");
+    }
+    content.remove_prefix(sizeof(MAGIC));
+
+    if (this->readNumber(content, sizeof(uint64_t)) != VERSION || this->readNumber(content, sizeof(uint64_t)) != sections.size())
+    {
+        throw std::runtime_error("Nepodporovan verzia obrazu dt!");
+    }
+
+    // jednotky sa vkladaju do sekvencii az ked je cely subor precitany bez chyby
+    // (jednotky z poskodeneho obrazu ostanu v sklade nepouzite a uvolnia sa spolu s nim)
+    std::vector<std::vector<Unit*>> loaded(sections.size());
+    for (auto& units : loaded)
+    {
+        uint64_t count = this->readNumber(content, sizeof(uint64_t));
+        units.reserve(static_cast<size_t>((std::min)(count, static_cast<uint64_t>(content.size()))));
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            size_t sortNumber = static_cast<size_t>(this->readNumber(content, sizeof(uint64_t)));
+            size_t kindergartenNum = static_cast<size_t>(this->readNumber(content, sizeof(uint64_t)));
+            std::string_view code{ this->readString(content) };
+            std::string_view officialTitle{ this->readString(content) };
+            std::string_view mediumTitle{ this->readString(content) };
+            std::string_view shortTitle{ this->readString(content) };
+            std::string_view note{ this->readString(content) };
+            std::string_view altTitle{ this->readString(content) };
+            units.push_back(store.create(sortNumber, code, officialTitle, mediumTitle, shortTitle, note, kindergartenNum, altTitle));
+        }
+    }
+
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        sections[i]->reserveCapacity(sections[i]->size() + loaded[i].size());
+        for (Unit* unit : loaded[i])
+        {
+            sections[i]->insertLast().data_ = unit;
+        }
+    }
+}
+
+void UnitSnapshot::writeNumber(std::string& buffer, uint64_t number) const
+{
+    char bytes[sizeof(uint64_t)];
+    std::memcpy(bytes, &number, sizeof(uint64_t));
+    buffer.append(bytes, sizeof(uint64_t));
+}
+
+void UnitSnapshot::writeString(std::string& buffer, std::string_view str) const
+{
+    uint32_t length = static_cast<uint32_t>(str.size());
+    char bytes[sizeof(uint32_t)];
+    std::memcpy(bytes, &length, sizeof(uint32_t));
+    buffer.append(bytes, sizeof(uint32_t));
+    buffer.append(str.data(), str.size());
+}
+
+uint64_t UnitSnapshot::readNumber(std::string_view& content, size_t size) const
+{
+    if (content.size() < size)
+    {
+        throw std::runtime_error("Neplatn sbor s obrazom dt!");
+    }
+
+    uint64_t number{};
+    std::memcpy(&number, content.data(), size);
+    content.remove_prefix(size);
+    return number;
+}
+
+std::string_view UnitSnapshot::readString(std::string_view& content) const
+{
+    size_t length = static_cast<size_t>(this->readNumber(content, sizeof(uint32_t)));
+    if (content.size() < length)
+    {
+        throw std::runtime_error("Neplatn sbor s obrazom dt!");
+    }
+
+    std::string_view str{ content.substr(0, length) };
+    content.remove_prefix(length);
+    return str;
+}
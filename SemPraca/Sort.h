@@ -7,7 +7,7 @@ struct CompareAlphabetical
 {
 	bool operator()(Unit* unit1, Unit* unit2) const
 	{
-		return std::locale("Slovak_Slovakia.1250")(unit1->getOfficialTitle(), unit2->getOfficialTitle());
+		return std::locale("Slovak_Slovakia.1250")(std::string(unit1->getOfficialTitle()), std::string(unit2->getOfficialTitle()));
 	}
 };
 
@@ -23,11 +23,8 @@ struct CompareHierarchically
 {
 	bool operator()(Unit* unit1, Unit* unit2) const
 	{
-		if (unit1->getCode().substr(3, 2) == unit2->getCode().substr(3, 2))
-		{
-			return unit1->getCode().substr(5, 1)[0] < unit2->getCode().substr(5, 1)[0];
-		}
-		return unit1->district() < unit2->district();
+		// v ramci kraja rozhoduje posledna cifra okresu, inak cislo okresu => v oboch pripadoch staci porovnat cislo okresu
+		return unit1->getDistrictId() < unit2->getDistrictId();
 	}
 };
 
@@ -39,6 +36,8 @@ public:
 	~Sort();
 	void sort(ds::amt::ImplicitSequence<T>& is, std::function<bool(const T&, const T&)> compare);
 	void chooseSort(ds::amt::ImplicitSequence<T>& is);
+	// utriedi podla poradia: v abecednom poradi [a] | podla poctu samohlasok [s]
+	void sortBy(ds::amt::ImplicitSequence<T>& is, char order);
 
 private:
 	ds::adt::MergeSort<T>* mergeSort;
@@ -70,9 +69,9 @@ void Sort<T>::chooseSort(ds::amt::ImplicitSequence<T>& is)
 	InputCheck().checkInput(cmpIn, "Utriedi: v abecednom porad [a] | poda potu samohlsok [s]: ", "Nesprvny vstup. Zadajte znova: ",
 		[&cmpIn]() -> bool { return cmpIn != 'a' && cmpIn != 's'; });
 
+	this->sortBy(is, cmpIn);
 	if (cmpIn == 'a')
 	{
-		this->sort(is, CompareAlphabetical());
 		for (auto unit : is)
 		{
 			std::cout << '\t' << *unit << " | " << unit->getOfficialTitle() << '\n';
@@ -80,7 +79,6 @@ void Sort<T>::chooseSort(ds::amt::ImplicitSequence<T>& is)
 	}
 	else
 	{
-		this->sort(is, CompareVowelsCount());
 		for (auto unit : is)
 		{
 			std::cout << '\t' << *unit << " | " << unit->vowelsCount() << '\n';
@@ -89,3 +87,19 @@ void Sort<T>::chooseSort(ds::amt::ImplicitSequence<T>& is)
 
 	std::cout << "\n=== KONIEC ROVNE 4 ===\n\n";
 }
+
+template<typename T>
+void Sort<T>::sortBy(ds::amt::ImplicitSequence<T>& is, char order)
+{
+	switch (order)
+	{
+	case 'a':
+		this->sort(is, CompareAlphabetical());
+		break;
+	case 's':
+		this->sort(is, CompareVowelsCount());
+		break;
+	default:
+		throw std::invalid_argument("Neznme poradie triedenia!");
+	}
+}
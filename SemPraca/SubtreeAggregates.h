@@ -0,0 +1,117 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include "Unit.h"
+#include "FlatHierarchy.h"
+
+// suhrnne hodnoty podstromu, pocitaju sa z obci (jednotiek typu 3) v podstrome
+// novy suhrn: hodnota v enum, riadok v registri v SubtreeAggregates::registry() (prispevok obce, neutralna hodnota, spojenie)
+enum SubtreeAggregate : uint8_t
+{
+    KINDERGARTEN_SUM,
+    MUNICIPALITY_COUNT,
+    KINDERGARTEN_MIN,
+    KINDERGARTEN_MAX,
+    SUBTREE_AGGREGATE_COUNT
+};
+
+// suhrny pre kazdy vrchol zmrazenej hierarchie => dotaz na suhrn podstromu je O(1)
+// vytvaraju sa zdola nahor; po zmene hodnot jednotky sa prepocitaju len vrchol a jeho predkovia
+class SubtreeAggregates
+{
+public:
+    void build(const FlatHierarchy<Unit*>& hierarchy);
+    // jednotka vrchola node zmenila hodnoty => prepocita suhrny na ceste ku korenu
+    void update(size_t node);
+
+    size_t get(size_t node, SubtreeAggregate aggregate) const { return this->values[node][aggregate]; };
+    // podstrom bez obci ma pri min / max neutralnu hodnotu
+    bool isEmpty(size_t node) const { return this->get(node, MUNICIPALITY_COUNT) == 0; };
+
+private:
+    using Values = std::array<size_t, SUBTREE_AGGREGATE_COUNT>;
+
+    struct Definition
+    {
+        size_t (*value)(const Unit& municipality);
+        size_t identity;
+        size_t (*combine)(size_t value1, size_t value2);
+    };
+
+    static const std::array<Definition, SUBTREE_AGGREGATE_COUNT>& registry();
+    Values ownValues(size_t node) const;
+    void combine(Values& target, const Values& source) const;
+    void recompute(size_t node);
+
+private:
+    const FlatHierarchy<Unit*>* hierarchy{ nullptr };
+    std::vector<Values> values{};
+};
+
+const std::array<SubtreeAggregates::Definition, SUBTREE_AGGREGATE_COUNT>& SubtreeAggregates::registry()
+{
+    static const std::array<Definition, SUBTREE_AGGREGATE_COUNT> definitions{ {
+        { [](const Unit& municipality) -> size_t { return municipality.getKindergartenNum(); }, 0, [](size_t value1, size_t value2) { return value1 + value2; } },
+        { [](const Unit&) -> size_t { return 1; }, 0, [](size_t value1, size_t value2) { return value1 + value2; } },
+        { [](const Unit& municipality) -> size_t { return municipality.getKindergartenNum(); }, (std::numeric_limits<size_t>::max)(), [](size_t value1, size_t value2) { return (std::min)(value1, value2); } },
+        { [](const Unit& municipality) -> size_t { return municipality.getKindergartenNum(); }, 0, [](size_t value1, size_t value2) { return (std::max)(value1, value2); } },
+    } };
+    return definitions;
+}
+
+void SubtreeAggregates::build(const FlatHierarchy<Unit*>& hierarchy)
+{
+    this->hierarchy = &hierarchy;
+    this->values.resize(hierarchy.size());
+    for (size_t node = 0; node < hierarchy.size(); ++node)
+    {
+        this->values[node] = this->ownValues(node);
+    }
+
+    // v pre-order je kazdy potomok za svojim otcom => od konca sa otec spoji az so suhrnmi vsetkych synov
+    for (size_t node = hierarchy.size(); node-- > 1;)
+    {
+        this->combine(this->values[hierarchy.accessParent(node)], this->values[node]);
+    }
+}
+
+void SubtreeAggregates::update(size_t node)
+{
+    // min / max sa nedaju odcitat => kazdy vrchol na ceste sa spoji znova zo svojich synov
+    for (; node != FlatHierarchy<Unit*>::NONE; node = this->hierarchy->accessParent(node))
+    {
+        this->recompute(node);
+    }
+}
+
+SubtreeAggregates::Values SubtreeAggregates::ownValues(size_t node) const
+{
+    Values own{};
+    const Unit& unit = *this->hierarchy->access(node);
+    for (size_t aggregate = 0; aggregate < SUBTREE_AGGREGATE_COUNT; ++aggregate)
+    {
+        own[aggregate] = unit.getType() == 3 ? registry()[aggregate].value(unit) : registry()[aggregate].identity;
+    }
+    return own;
+}
+
+void SubtreeAggregates::combine(Values& target, const Values& source) const
+{
+    for (size_t aggregate = 0; aggregate < SUBTREE_AGGREGATE_COUNT; ++aggregate)
+    {
+        target[aggregate] = registry()[aggregate].combine(target[aggregate], source[aggregate]);
+    }
+}
+
+void SubtreeAggregates::recompute(size_t node)
+{
+    Values recomputed = this->ownValues(node);
+    for (size_t son = 0; son < this->hierarchy->degree(node); ++son)
+    {
+        this->combine(recomputed, this->values[this->hierarchy->accessSon(node, son)]);
+    }
+    this->values[node] = recomputed;
+}
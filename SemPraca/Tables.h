@@ -2,38 +2,62 @@
 #include <libds/adt/table.h>
 #include <libds/adt/list.h>
 #include "Unit.h"
+#include "QueryCache.h"
+#include "ResultCursor.h"
+#include "BKTree.h"
+#include "Cp1250.h"
 
 template <typename DataType, typename ISType>
 class Tables
 {
 private:
-	ds::adt::ModifiedTreap<std::string, ds::adt::ImplicitList<DataType*>, DataType*> tabRegions{};
-	ds::adt::ModifiedTreap<std::string, ds::adt::ImplicitList<DataType*>, DataType*> tabDistricts{};
-	ds::adt::ModifiedTreap<std::string, ds::adt::ImplicitList<DataType*>, DataType*> tabMunicipalities{};
+	ds::adt::ModifiedTreap<std::string_view, ds::adt::ImplicitList<DataType*>, DataType*> tabRegions{};
+	ds::adt::ModifiedTreap<std::string_view, ds::adt::ImplicitList<DataType*>, DataType*> tabDistricts{};
+	ds::adt::ModifiedTreap<std::string_view, ds::adt::ImplicitList<DataType*>, DataType*> tabMunicipalities{};
+	ds::adt::ModifiedTreap<std::string_view, ds::adt::ImplicitList<DataType*>, DataType*> foldedRegions{};		// kluc je zlozeny nazov (bez diakritiky, malymi pismenami)
+	ds::adt::ModifiedTreap<std::string_view, ds::adt::ImplicitList<DataType*>, DataType*> foldedDistricts{};
+	ds::adt::ModifiedTreap<std::string_view, ds::adt::ImplicitList<DataType*>, DataType*> foldedMunicipalities{};
+	BKTree similarRegions{};				// priblizne vyhladavanie nazvov (preklepy, chybajuca diakritika)
+	BKTree similarDistricts{};
+	BKTree similarMunicipalities{};
+	QueryCache& cache;
+
+	static constexpr size_t SIMILAR_DISTANCE = 2;		// ponuka pri nenajdenom nazve
+	static constexpr size_t SIMILAR_COUNT = 5;
 
 public:
-	Tables(ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities);
+	Tables(QueryCache& cache, ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities);
 	~Tables();
 	void displayUnitInfo();
+	// jednotky typu unitType s danym nazvom (pri FOLDED_MATCH bez ohladu na diakritiku a velkost pismen); nenajdeny nazov vyhodi vynimku pri prechode kurzorom
+	ResultCursor findUnits(size_t unitType, const std::string& title, TitleMatch match = EXACT_MATCH);
+	// jednotky typu unitType s nazvom vo vzdialenosti najviac maxDistance od title, od najblizsej; k najblizsich = limit kurzora
+	ResultCursor findSimilar(size_t unitType, const std::string& title, size_t maxDistance);
 	//void loadKindergartenNums();
 };
 
 template <typename DataType, typename ISType>
-Tables<DataType, ISType>::Tables(ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities)
+Tables<DataType, ISType>::Tables(QueryCache& cache, ISType& ISregions, ISType& ISdistricts, ISType& ISmunicipalities) : cache(cache)
 {
 	for (DataType* dataUnit : ISregions)
 	{
 		tabRegions.insert(dataUnit->getOfficialTitle(), dataUnit);
+		foldedRegions.insert(dataUnit->getFoldedTitle(), dataUnit);
+		similarRegions.insert(dataUnit);
 	}
 
 	for (DataType* dataUnit : ISdistricts)
 	{
 		tabDistricts.insert(dataUnit->getOfficialTitle(), dataUnit);
+		foldedDistricts.insert(dataUnit->getFoldedTitle(), dataUnit);
+		similarDistricts.insert(dataUnit);
 	}
 
 	for (DataType* dataUnit : ISmunicipalities)
 	{
 		tabMunicipalities.insert(dataUnit->getOfficialTitle(), dataUnit);
+		foldedMunicipalities.insert(dataUnit->getFoldedTitle(), dataUnit);
+		similarMunicipalities.insert(dataUnit);
 	}
 
 	//this->loadKindergartenNums();
@@ -42,6 +66,7 @@ Tables<DataType, ISType>::Tables(ISType& ISregions, ISType& ISdistricts, ISType&
 template <typename DataType, typename ISType>
 Tables<DataType, ISType>::~Tables()
 {
+	// uvolnia sa iba zoznamy synonym, jednotky patria UnitStore
 	for (auto data : tabRegions)
 	{
 		delete data.data_;
@@ -57,9 +82,27 @@ Tables<DataType, ISType>::~Tables()
 		delete data.data_;
 	}
 
+	for (auto data : foldedRegions)
+	{
+		delete data.data_;
+	}
+
+	for (auto data : foldedDistricts)
+	{
+		delete data.data_;
+	}
+
+	for (auto data : foldedMunicipalities)
+	{
+		delete data.data_;
+	}
+
 	tabRegions.clear();
 	tabDistricts.clear();
 	tabMunicipalities.clear();
+	foldedRegions.clear();
+	foldedDistricts.clear();
+	foldedMunicipalities.clear();
 }
 
 template<typename DataType, typename ISType>
@@ -79,31 +122,39 @@ void Tables<DataType, ISType>::displayUnitInfo()
 		
 		try
 		{
-			switch (unitType)
-			{
-			case 1:
-				for (auto dataUnit : *tabRegions.find(nazov))
-				{
-					std::cout << '\t' << *dataUnit << '\n';
-				}
-				break;
-			case 2:
-				for (auto dataUnit : *tabDistricts.find(nazov))
-				{
-					std::cout << '\t' << *dataUnit << '\n';
-				}
-				break;
-			case 3:
-				for (auto dataUnit : *tabMunicipalities.find(nazov))
-				{
-					std::cout << '\t' << *dataUnit << '\n';
-				}
-				break;
-			}
+			this->findUnits(unitType, nazov).forEach([](Unit* dataUnit) { std::cout << '\t' << *dataUnit << '\n'; });
 		}
 		catch (const std::exception& err)
 		{
-			std::cout << err.what() << "\n\n";
+			// nazov bez diakritiky alebo inou velkostou pismen => jednotky so zhodnym zlozenym nazvom
+			size_t foldedCount{ 0 };
+			try
+			{
+				foldedCount = this->findUnits(unitType, nazov, FOLDED_MATCH).forEach([](Unit* dataUnit) { std::cout << '\t' << *dataUnit << '\n'; });
+			}
+			catch (const std::exception&)
+			{
+				// ani zlozeny nazov sa nenasiel, vypise sa povodna chyba
+			}
+			if (foldedCount == 0)
+			{
+				std::cout << err.what() << "\n";
+
+				// preklep v nazve => ponuknu sa najpodobnejsie nazvy
+				ResultCursor similar{ this->findSimilar(unitType, nazov, SIMILAR_DISTANCE) };
+				similar.setLimit(SIMILAR_COUNT);
+				bool first{ true };
+				similar.forEach([&first](Unit* dataUnit)
+					{
+						if (first)
+						{
+							std::cout << "Podobn nzvy:\n";
+							first = false;
+						}
+						std::cout << '\t' << *dataUnit << '\n';
+					});
+				std::cout << "\n";
+			}
 		}
 
 		InputCheck().checkInput(cont, "Pokraova? [0/1]: ", "Nesprvny vstup. Zadajte znova: ", [&cont]() -> bool { return cont != 0 && cont != 1; });
@@ -114,6 +165,53 @@ void Tables<DataType, ISType>::displayUnitInfo()
 	std::cout << "=== KONIEC ROVNE 3 ===\n\n";
 }
 
+template<typename DataType, typename ISType>
+ResultCursor Tables<DataType, ISType>::findUnits(size_t unitType, const std::string& title, TitleMatch match)
+{
+	if (unitType < 1 || unitType > 3)
+	{
+		throw std::invalid_argument("Neznmy typ zemnej jednotky!");
+	}
+	auto* table{ match == FOLDED_MATCH ?
+		(unitType == 1 ? &foldedRegions : unitType == 2 ? &foldedDistricts : &foldedMunicipalities) :
+		(unitType == 1 ? &tabRegions : unitType == 2 ? &tabDistricts : &tabMunicipalities) };
+	std::string key{ match == FOLDED_MATCH ? Cp1250::fold(title) : title };
+
+	// nenajdeny nazov vyhodi vynimku a do vyrovnavacej pamate sa neulozi
+	return ResultCursor::cached(cache, { table, match == FOLDED_MATCH ? 'N' : 'n', key }, [table, key](const ResultCursor::Yield& yield)
+		{
+			for (auto dataUnit : *table->find(key))
+			{
+				if (!yield(dataUnit))
+				{
+					return;
+				}
+			}
+		});
+}
+
+template<typename DataType, typename ISType>
+ResultCursor Tables<DataType, ISType>::findSimilar(size_t unitType, const std::string& title, size_t maxDistance)
+{
+	if (unitType < 1 || unitType > 3)
+	{
+		throw std::invalid_argument("Neznmy typ zemnej jednotky!");
+	}
+	const BKTree* similar{ unitType == 1 ? &similarRegions : unitType == 2 ? &similarDistricts : &similarMunicipalities };
+
+	// vysledky su zoradene podla vzdialenosti, preto sa najprv najdu vsetky do vzdialenosti maxDistance
+	return ResultCursor::cached(cache, { similar, 'p', title + '~' + std::to_string(maxDistance) }, [similar, title, maxDistance](const ResultCursor::Yield& yield)
+		{
+			for (Unit* dataUnit : similar->findClosest(title, maxDistance, similar->size()))
+			{
+				if (!yield(dataUnit))
+				{
+					return;
+				}
+			}
+		});
+}
+
 //template<typename DataType, typename ISType>
 //void Tables<DataType, ISType>::loadKindergartenNums()
 //{
@@ -0,0 +1,186 @@
+#pragma once
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+#include "UnitColumns.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TITLE_SCAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TITLE_SCAN_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// hrube prehladanie nazvov priamo v jednom suvislom bloku bajtov (StringColumn), bez volania predikatu pre kazdu jednotku
+// s AVX2 / SSE2 sa naraz porovna 32 / 16 pozicii, inak sa porovnava po bajtoch; vysledky su rovnake ako containsStr / startsWithStr
+// pri FOLDED_MATCH sa prehladavaju zlozene nazvy a searched uz musi byt zlozeny; ak process vrati false, prehladavanie skonci
+class TitleScan
+{
+public:
+    // spracuje riadky z [firstRow, endRow), ktorych nazov obsahuje searched, vo vzostupnom poradi riadkov
+    static void findContaining(const UnitColumns& columns, const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process);
+    // to iste pre nazvy zacinajuce na searched
+    static void findStartingWith(const UnitColumns& columns, const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process);
+
+private:
+#if defined(TITLE_SCAN_AVX2)
+    static constexpr size_t WIDTH = 32;
+#elif defined(TITLE_SCAN_SSE2)
+    static constexpr size_t WIDTH = 16;
+#else
+    static constexpr size_t WIDTH = 0;
+#endif
+
+    static uint32_t edgeMask(const char* text, size_t length, char first, char last);
+    static uint32_t equalMask(const char* text, const char* pattern);
+    static size_t countTrailingZeros(uint32_t mask);
+};
+
+void TitleScan::findContaining(const UnitColumns& columns, const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process)
+{
+    const StringColumn& titles{ columns.getTitles(match) };
+    const char* bytes = titles.getBytes();
+    size_t length = searched.size();
+
+    size_t row = firstRow;
+    size_t lastFound = endRow;
+    bool stopped = false;
+    auto tryPosition = [&](size_t position)
+        {
+            // pozicie idu vzostupne, riadok sa posuva spolu s nimi; zhoda nesmie presahovat do dalsieho nazvu
+            while (titles.getOffset(row + 1) <= position)
+            {
+                ++row;
+            }
+            if (row != lastFound && position + length <= titles.getOffset(row + 1) && std::memcmp(bytes + position, searched.data(), length) == 0)
+            {
+                lastFound = row;
+                UnitRow unitRow{ columns.access(row) };
+                stopped = !process(unitRow);
+            }
+        };
+
+    if (length == 0)
+    {
+        for (; row < endRow; ++row)
+        {
+            UnitRow unitRow{ columns.access(row) };
+            if (!process(unitRow))
+            {
+                return;
+            }
+        }
+        return;
+    }
+
+    size_t begin = titles.getOffset(firstRow);
+    size_t end = titles.getOffset(endRow);
+    if (end - begin < length)
+    {
+        return;
+    }
+
+    // kandidat je pozicia, kde sedi prvy aj posledny bajt hladaneho retazca
+    size_t lastStart = end - length;
+    size_t position = begin;
+    if constexpr (WIDTH > 0)
+    {
+        for (; position + WIDTH - 1 <= lastStart && !stopped; position += WIDTH)
+        {
+            for (uint32_t mask = edgeMask(bytes + position, length, searched.front(), searched.back()); mask != 0 && !stopped; mask &= mask - 1)
+            {
+                tryPosition(position + countTrailingZeros(mask));
+            }
+        }
+    }
+    for (; position <= lastStart && !stopped; ++position)
+    {
+        if (bytes[position] == searched.front() && bytes[position + length - 1] == searched.back())
+        {
+            tryPosition(position);
+        }
+    }
+}
+
+void TitleScan::findStartingWith(const UnitColumns& columns, const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process)
+{
+    const StringColumn& titles{ columns.getTitles(match) };
+    const char* bytes = titles.getBytes();
+    size_t length = searched.size();
+    size_t totalBytes = titles.getOffset(columns.size());
+
+    // kratka predpona sa porovna jednym vektorovym porovnanim so zaciatkom nazvu
+    char pattern[WIDTH > 0 ? WIDTH : 1]{};
+    bool vectorized = WIDTH > 0 && length <= WIDTH;
+    if (vectorized)
+    {
+        std::memcpy(pattern, searched.data(), length);
+    }
+    uint32_t prefixMask = length >= 32 ? 0xFFFFFFFFu : (1u << length) - 1;
+
+    for (size_t row = firstRow; row < endRow; ++row)
+    {
+        size_t start = titles.getOffset(row);
+        if (titles.getOffset(row + 1) - start < length)
+        {
+            continue;
+        }
+
+        bool found = vectorized && start + WIDTH <= totalBytes ?
+            (equalMask(bytes + start, pattern) & prefixMask) == prefixMask :
+            std::memcmp(bytes + start, searched.data(), length) == 0;
+        if (found)
+        {
+            UnitRow unitRow{ columns.access(row) };
+            if (!process(unitRow))
+            {
+                return;
+            }
+        }
+    }
+}
+
+uint32_t TitleScan::edgeMask(const char* text, size_t length, char first, char last)
+{
+    // bit i = text[i] je prvy a text[i + length - 1] posledny bajt hladaneho retazca
+#if defined(TITLE_SCAN_AVX2)
+    __m256i firstBytes = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text)), _mm256_set1_epi8(first));
+    __m256i lastBytes = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + length - 1)), _mm256_set1_epi8(last));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(firstBytes, lastBytes)));
+#elif defined(TITLE_SCAN_SSE2)
+    __m128i firstBytes = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), _mm_set1_epi8(first));
+    __m128i lastBytes = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + length - 1)), _mm_set1_epi8(last));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(firstBytes, lastBytes)));
+#else
+    return 0;
+#endif
+}
+
+uint32_t TitleScan::equalMask(const char* text, const char* pattern)
+{
+    // bit i = text[i] == pattern[i]
+#if defined(TITLE_SCAN_AVX2)
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern)))));
+#elif defined(TITLE_SCAN_SSE2)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern)))));
+#else
+    return 0;
+#endif
+}
+
+size_t TitleScan::countTrailingZeros(uint32_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index{};
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+}
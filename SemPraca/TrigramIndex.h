@@ -0,0 +1,207 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "UnitColumns.h"
+#include "TitleScan.h"
+#include "Cp1250.h"
+
+// zoznam riadkov (vzostupne) ulozeny ako rozdiely susednych riadkov v kodovani varint => vacsina riadkov zaberie 1 bajt
+class PostingList
+{
+public:
+    class Reader
+    {
+    public:
+        Reader(const PostingList& list) : position(list.bytes.data()), end(list.bytes.data() + list.bytes.size()) {};
+        bool next(uint32_t& row);
+
+    private:
+        const uint8_t* position;
+        const uint8_t* end;
+        uint32_t last{ 0 };
+    };
+
+    void insertLast(uint32_t row);
+    size_t size() const { return this->count; };
+    uint32_t getLast() const { return this->last; };
+    void shrink() { this->bytes.shrink_to_fit(); };
+
+private:
+    std::vector<uint8_t> bytes{};
+    size_t count{ 0 };
+    uint32_t last{ 0 };
+};
+
+// invertovany index trojic znakov (trigramov) zlozenych nazvov => rychle hladanie podretazca
+// kandidati sa ziskaju prienikom zoznamov vsetkych trigramov hladaneho retazca a kazdy sa este overi
+// presna zhoda je aj zhodou zlozenych nazvov => jeden index sluzi obom sposobom porovnania, lisi sa len overenie
+class TrigramIndex
+{
+public:
+    void build(const UnitColumns& columns);
+
+    // spracuje riadky z [firstRow, endRow), ktorych nazov obsahuje searched, vo vzostupnom poradi riadkov; ak process vrati false, skonci
+    void findContaining(const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const;
+
+private:
+    static uint32_t trigram(const char* letters);
+
+private:
+    const UnitColumns* columns{ nullptr };
+    std::unordered_map<uint32_t, PostingList> postings{};
+};
+
+bool PostingList::Reader::next(uint32_t& row)
+{
+    if (this->position == this->end)
+    {
+        return false;
+    }
+
+    uint32_t delta{ 0 };
+    for (int shift = 0; ; shift += 7)
+    {
+        uint8_t byte = *this->position++;
+        delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            break;
+        }
+    }
+
+    this->last += delta;
+    row = this->last;
+    return true;
+}
+
+void PostingList::insertLast(uint32_t row)
+{
+    // prvy riadok sa ulozi ako rozdiel od 0
+    uint32_t delta = row - this->last;
+    while (delta >= 0x80)
+    {
+        this->bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    this->bytes.push_back(static_cast<uint8_t>(delta));
+
+    this->last = row;
+    ++this->count;
+}
+
+void TrigramIndex::build(const UnitColumns& columns)
+{
+    this->columns = &columns;
+    this->postings.clear();
+
+    for (size_t row = 0; row < columns.size(); ++row)
+    {
+        std::string_view title{ columns.access(row).getFoldedTitle() };
+        for (size_t i = 0; i + 3 <= title.size(); ++i)
+        {
+            PostingList& list{ this->postings[trigram(title.data() + i)] };
+            if (list.size() == 0 || list.getLast() != row)        // trigram opakovany v tom istom nazve sa zapise raz
+            {
+                list.insertLast(static_cast<uint32_t>(row));
+            }
+        }
+    }
+
+    for (auto& [key, list] : this->postings)
+    {
+        list.shrink();
+    }
+}
+
+void TrigramIndex::findContaining(const std::string& searched, TitleMatch match, size_t firstRow, size_t endRow, const std::function<bool(UnitRow&)>& process) const
+{
+    endRow = (std::min)(endRow, this->columns->size());
+    const std::string folded{ Cp1250::fold(searched) };
+    const std::string& compared{ match == FOLDED_MATCH ? folded : searched };
+
+    // kratky retazec nema ziadny trigram => prehliadka vsetkych riadkov
+    if (searched.size() < 3)
+    {
+        TitleScan::findContaining(*this->columns, compared, match, firstRow, endRow, process);
+        return;
+    }
+
+    std::vector<const PostingList*> lists{};
+    for (size_t i = 0; i + 3 <= folded.size(); ++i)
+    {
+        auto position = this->postings.find(trigram(folded.data() + i));
+        if (position == this->postings.end())
+        {
+            return;                 // niektory trigram sa nevyskytuje v ziadnom nazve
+        }
+        lists.push_back(&position->second);
+    }
+
+    // prienik sa zacne od najkratsieho zoznamu, kandidati len ubudaju
+    std::sort(lists.begin(), lists.end(), [](const PostingList* list1, const PostingList* list2) { return list1->size() < list2->size(); });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    // ak by sa dekodovalo viac polozek, nez ma usek riadkov, je rychlejsie usek priamo prehladat
+    if (lists.front()->size() > endRow - firstRow)
+    {
+        TitleScan::findContaining(*this->columns, compared, match, firstRow, endRow, process);
+        return;
+    }
+
+    std::vector<uint32_t> candidates{};
+    candidates.reserve(lists.front()->size());
+    PostingList::Reader first{ *lists.front() };
+    for (uint32_t row; first.next(row) && row < endRow;)
+    {
+        if (row >= firstRow)
+        {
+            candidates.push_back(row);
+        }
+    }
+
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i)
+    {
+        PostingList::Reader reader{ *lists[i] };
+        size_t kept{ 0 };
+        uint32_t row{ 0 };
+        bool hasRow = reader.next(row);
+        for (uint32_t candidate : candidates)
+        {
+            while (hasRow && row < candidate)
+            {
+                hasRow = reader.next(row);
+            }
+            if (!hasRow)
+            {
+                break;
+            }
+            if (row == candidate)
+            {
+                candidates[kept++] = candidate;
+            }
+        }
+        candidates.resize(kept);
+    }
+
+    // vsetky trigramy sediet este neznamena, ze sediet aj ich poradie => overenie
+    for (uint32_t candidate : candidates)
+    {
+        UnitRow unitRow{ this->columns->access(candidate) };
+        if (unitRow.containsStr(compared, match) && !process(unitRow))
+        {
+            return;
+        }
+    }
+}
+
+uint32_t TrigramIndex::trigram(const char* letters)
+{
+    return static_cast<uint32_t>(static_cast<unsigned char>(letters[0])) << 16
+        | static_cast<uint32_t>(static_cast<unsigned char>(letters[1])) << 8
+        | static_cast<uint32_t>(static_cast<unsigned char>(letters[2]));
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <cstdint>
 
 struct InputCheck
 {
@@ -43,77 +45,125 @@ struct InputCheck
     }
 };
 
+// porovnanie nazvov: presne po bajtoch, alebo bez diakritiky a velkosti pismen (zlozeny nazov, Cp1250::fold)
+enum TitleMatch : uint8_t
+{
+    EXACT_MATCH,
+    FOLDED_MATCH
+};
+
+// odvodene atributy jednotky, pocitaju sa raz pri nacitani (DerivedAttributes.h)
+enum DerivedAttribute : uint8_t
+{
+    VOWELS_COUNT,
+    DERIVED_ATTRIBUTE_COUNT
+};
+
 class Unit
 {
 private:
+    // retazce nevlastni, ukazuju do pamate UnitStore
     size_t sortNumber{};
-    std::string code{};
-    std::string officialTitle{};
-    std::string mediumTitle{};
-    std::string shortTitle{};
-    std::string note{};
+    std::string_view code{};
+    std::string_view officialTitle{};
+    std::string_view mediumTitle{};
+    std::string_view shortTitle{};
+    std::string_view note{};
     size_t kindergartenNum{};
-    std::string altTitle{};
+    std::string_view altTitle{};
+    std::string_view foldedTitle{};     // oficialny nazov zlozeny pri nacitani, hladanie bez diakritiky porovnava tento
+
+    // kod rozlozeny pri nacitani, napr. SK0101528595 -> kraj "10", okres "101", obec "528595" (cisla v sustave so zakladom 36)
+    uint32_t localId{};
+    uint16_t districtId{};
+    uint16_t regionId{};
+    uint8_t type{};
+
+    uint16_t derived[DERIVED_ATTRIBUTE_COUNT]{};
+
+    void decodeCode();
 
 public:
-    Unit(size_t sortNumber, const std::string& code, const std::string& officialTitle, const std::string& mediumTitle, const std::string& shortTitle, const std::string& note, size_t kindergartenNum, const std::string& altTitle) :
-        sortNumber(sortNumber), code(code), officialTitle(officialTitle), mediumTitle(mediumTitle), shortTitle(shortTitle), note(note), kindergartenNum(kindergartenNum), altTitle(altTitle) {};
+    static constexpr uint16_t FOREIGN_REGION = 35 * 36 + 35;   // kraj Zahranicie (ZZ)
+    static uint32_t decodeNumber(std::string_view digits);
+
+    Unit(size_t sortNumber, std::string_view code, std::string_view officialTitle, std::string_view mediumTitle, std::string_view shortTitle, std::string_view note, size_t kindergartenNum, std::string_view altTitle) :
+        sortNumber(sortNumber), code(code), officialTitle(officialTitle), mediumTitle(mediumTitle), shortTitle(shortTitle), note(note), kindergartenNum(kindergartenNum), altTitle(altTitle) { this->decodeCode(); };
 
     bool containsStr(const std::string& searched)
-        { return this->officialTitle.find(searched) != std::string::npos; };
+        { return this->officialTitle.find(searched) != std::string_view::npos; };
 
     bool startsWithStr(const std::string& searched)
         { return this->officialTitle.rfind(searched, 0) == 0; };
 
-    bool hasType(const size_t type);
-
-    size_t& getSortNumber() { return this->sortNumber; };
-    std::string& getCode() { return this->code; };
-    std::string& getOfficialTitle() { return this->officialTitle; };
-    std::string& getMediumTitle() { return this->mediumTitle; };
-    std::string& getShortTitle() { return this->shortTitle; };
-    std::string& getNote() { return this->note; };
-    std::string& getAltTitle() { return this->altTitle; };
-    size_t& getKindergartenNum() { return this->kindergartenNum; };
-
-    std::string district();
-    size_t vowelsCount();
+    bool hasType(const size_t type) const { return this->type == type; };
+
+    size_t getSortNumber() const { return this->sortNumber; };
+    std::string_view getCode() const { return this->code; };
+    std::string_view getOfficialTitle() const { return this->officialTitle; };
+    std::string_view getMediumTitle() const { return this->mediumTitle; };
+    std::string_view getShortTitle() const { return this->shortTitle; };
+    std::string_view getNote() const { return this->note; };
+    std::string_view getAltTitle() const { return this->altTitle; };
+    std::string_view getFoldedTitle() const { return this->foldedTitle; };
+    void setFoldedTitle(std::string_view foldedTitle) { this->foldedTitle = foldedTitle; };
+    std::string_view getTitle(TitleMatch match) const { return match == FOLDED_MATCH ? this->foldedTitle : this->officialTitle; };
+    size_t getKindergartenNum() const { return this->kindergartenNum; };
+    void setKindergartenNum(size_t kindergartenNum) { this->kindergartenNum = kindergartenNum; };
+    size_t getType() const { return this->type; };
+    size_t getRegionId() const { return this->regionId; };
+    size_t getDistrictId() const { return this->districtId; };
+    size_t getLocalId() const { return this->localId; };
+    size_t getDerived(DerivedAttribute attribute) const { return this->derived[attribute]; };
+    void setDerived(DerivedAttribute attribute, size_t value) { this->derived[attribute] = static_cast<uint16_t>(value); };
+
+    size_t vowelsCount() const { return this->getDerived(VOWELS_COUNT); };
 
     friend std::ostream& operator<<(std::ostream& output, const Unit& unit);
 };
 
-bool Unit::hasType(const size_t type)
+void Unit::decodeCode()
 {
-    if (type == 1)
+    // typ: kraj [1] ma jednoznakovy kod, okres [2] SKkko, obec [3] SKkkoxxxxxx; SKZZZZ je okres aj obec (obec ma poradie 2929)
+    // ostatne kody (koren SK) nemaju ziadny typ
+    size_t length = this->code.length();
+    if (length == 1)
     {
-        return this->code.length() == 1;
+        this->type = 1;
     }
-    else if (type == 2)
+    else if (length == 5 || (length == 6 && this->sortNumber != 2929))
     {
-        return this->code.length() == 5 || (this->code.length() == 6 && this->sortNumber != 2929);
+        this->type = 2;
+    }
+    else if (length == 12 || (length == 6 && this->sortNumber == 2929))
+    {
+        this->type = 3;
     }
-    return this->code.length() == 12 || (this->code.length() == 6 && this->sortNumber == 2929);
-}
 
-std::string Unit::district()
-{
-    return this->code.substr(3, 3);
+    // kraj nema cislo kraja v kode, ale na konci poznamky (BL-1-SK010)
+    std::string_view regional{ this->type == 1 ? this->note.substr(this->note.rfind('-') + 1) : this->code };
+    if (regional.length() >= 5)
+    {
+        this->regionId = static_cast<uint16_t>(decodeNumber(regional.substr(3, 2)));
+    }
+    if (this->type > 1)
+    {
+        this->districtId = static_cast<uint16_t>(decodeNumber(this->code.substr(3, 3)));
+        this->localId = length > 6 ? decodeNumber(this->code.substr(6)) : 0;
+    }
 }
 
-size_t Unit::vowelsCount()
+uint32_t Unit::decodeNumber(std::string_view digits)
 {
-    size_t vowelCount{ 0 };
-    std::string vowels{ "aeiouyAEIOUY" };
-
-    for (auto letter : this->officialTitle)
+    // okresy maju v kode aj pismena (SK031B), preto sa znaky citaju ako cifry 0-9, A-Z so zakladom 36 => poradie cisel je poradie kodov
+    // ine znaky (* v poznamke kraja Zahranicie) sa citaju ako Z, aby sa zahranicie zoradilo za vsetky ostatne kody
+    uint32_t number{ 0 };
+    for (char digit : digits)
     {
-        if (vowels.find(letter) != std::string::npos)
-        {
-            ++vowelCount;
-        }
+        uint32_t value = digit >= '0' && digit <= '9' ? digit - '0' : digit >= 'A' && digit <= 'Z' ? digit - 'A' + 10 : 35;
+        number = number * 36 + value;
     }
-
-    return vowelCount;
+    return number;
 }
 
 std::ostream& operator<<(std::ostream& output, const Unit& unit)
@@ -0,0 +1,186 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <cstdint>
+#include "Unit.h"
+
+// retazce jedneho stlpca ulozene za sebou v jednom poli, i-ty retazec je [offsets[i], offsets[i + 1])
+class StringColumn
+{
+public:
+    void insertLast(std::string_view str);
+    std::string_view access(size_t row) const { return std::string_view(this->bytes.data() + this->offsets[row], this->offsets[row + 1] - this->offsets[row]); };
+    void reserve(size_t rowCount, size_t byteCount);
+
+    const char* getBytes() const { return this->bytes.data(); };
+    uint32_t getOffset(size_t row) const { return this->offsets[row]; };
+
+private:
+    std::vector<char> bytes{};
+    std::vector<uint32_t> offsets{ 0 };
+};
+
+class UnitColumns;
+
+// pohlad na jeden riadok stlpcoveho ulozenia, ma rovnake metody ako Unit, ale cita zo suvislych poli
+class UnitRow
+{
+public:
+    UnitRow(const UnitColumns* columns, size_t row) : columns(columns), row(row) {};
+
+    // pri FOLDED_MATCH musi byt searched uz zlozeny (Cp1250::fold)
+    bool containsStr(const std::string& searched, TitleMatch match = EXACT_MATCH) const { return this->getTitle(match).find(searched) != std::string_view::npos; };
+    bool startsWithStr(const std::string& searched, TitleMatch match = EXACT_MATCH) const { return this->getTitle(match).rfind(searched, 0) == 0; };
+    bool hasType(const size_t type) const { return this->getType() == type; };
+
+    size_t getRow() const { return this->row; };
+    Unit* getUnit() const;
+    std::string_view getOfficialTitle() const;
+    std::string_view getFoldedTitle() const;
+    std::string_view getTitle(TitleMatch match) const { return match == FOLDED_MATCH ? this->getFoldedTitle() : this->getOfficialTitle(); };
+    std::string_view getCode() const;
+    size_t getKindergartenNum() const;
+    size_t getSortNumber() const;
+    size_t getType() const;
+
+private:
+    friend class UnitColumns;
+
+    const UnitColumns* columns;
+    size_t row;
+};
+
+// stlpcove ulozenie jednotiek (struct of arrays): kazdy atribut prehladavany filtrami je v jednom suvislom poli
+// riadok i zodpoveda i-tej vlozenej jednotke, ostatne atributy sa citaju cez smernik na Unit
+class UnitColumns
+{
+public:
+    class RowIterator
+    {
+    public:
+        RowIterator(const UnitColumns* columns, size_t row) : current(columns, row) {};
+
+        RowIterator& operator++() { ++this->current.row; return *this; };
+        void operator+(int count) { this->current.row += count; };
+        size_t operator-(const RowIterator& other) const { return this->current.row - other.current.row; };
+        bool operator==(const RowIterator& other) const { return this->current.row == other.current.row; };
+        bool operator!=(const RowIterator& other) const { return this->current.row != other.current.row; };
+        UnitRow& operator*() { return this->current; };
+
+    private:
+        UnitRow current;
+    };
+
+    void insertLast(Unit* unit);
+    void reserve(size_t rowCount);
+    size_t size() const { return this->units.size(); };
+
+    UnitRow access(size_t row) const { return UnitRow(this, row); };
+    RowIterator begin() const { return RowIterator(this, 0); };
+    RowIterator end() const { return RowIterator(this, this->size()); };
+    RowIterator rowIterator(size_t row) const { return RowIterator(this, row); };
+    const StringColumn& getTitles(TitleMatch match = EXACT_MATCH) const { return match == FOLDED_MATCH ? this->foldedTitles : this->titles; };
+    // riadok jednotky alebo NONE, ak v stlpcoch nie je
+    size_t findRow(const Unit* unit) const;
+    // zmeni len kopiu v stlpci; pocet sa meni cez ImplicitSequences::setKindergartenNum, ktory zmeni aj jednotku a ostatne kopie
+    void setKindergartenNum(size_t row, size_t kindergartenNum);
+
+    static constexpr size_t NONE = SIZE_MAX;
+
+private:
+    friend class UnitRow;
+
+    StringColumn titles{};
+    StringColumn foldedTitles{};        // rovnake offsety ako titles, zlozeny nazov ma rovnaku dlzku
+    StringColumn codes{};
+    std::vector<uint32_t> kindergartenNums{};
+    std::vector<uint32_t> sortNumbers{};
+    std::vector<uint8_t> types{};
+    std::vector<Unit*> units{};
+    std::unordered_map<const Unit*, uint32_t> rows{};
+};
+
+void StringColumn::insertLast(std::string_view str)
+{
+    this->bytes.insert(this->bytes.end(), str.begin(), str.end());
+    this->offsets.push_back(static_cast<uint32_t>(this->bytes.size()));
+}
+
+void StringColumn::reserve(size_t rowCount, size_t byteCount)
+{
+    this->bytes.reserve(byteCount);
+    this->offsets.reserve(rowCount + 1);
+}
+
+Unit* UnitRow::getUnit() const
+{
+    return this->columns->units[this->row];
+}
+
+std::string_view UnitRow::getOfficialTitle() const
+{
+    return this->columns->titles.access(this->row);
+}
+
+std::string_view UnitRow::getFoldedTitle() const
+{
+    return this->columns->foldedTitles.access(this->row);
+}
+
+std::string_view UnitRow::getCode() const
+{
+    return this->columns->codes.access(this->row);
+}
+
+size_t UnitRow::getKindergartenNum() const
+{
+    return this->columns->kindergartenNums[this->row];
+}
+
+size_t UnitRow::getSortNumber() const
+{
+    return this->columns->sortNumbers[this->row];
+}
+
+size_t UnitRow::getType() const
+{
+    return this->columns->types[this->row];
+}
+
+void UnitColumns::insertLast(Unit* unit)
+{
+    this->titles.insertLast(unit->getOfficialTitle());
+    this->foldedTitles.insertLast(unit->getFoldedTitle());
+    this->codes.insertLast(unit->getCode());
+    this->kindergartenNums.push_back(static_cast<uint32_t>(unit->getKindergartenNum()));
+    this->sortNumbers.push_back(static_cast<uint32_t>(unit->getSortNumber()));
+    this->types.push_back(static_cast<uint8_t>(unit->getType()));
+    this->rows.emplace(unit, static_cast<uint32_t>(this->units.size()));
+    this->units.push_back(unit);
+}
+
+size_t UnitColumns::findRow(const Unit* unit) const
+{
+    auto found = this->rows.find(unit);
+    return found == this->rows.end() ? NONE : found->second;
+}
+
+void UnitColumns::setKindergartenNum(size_t row, size_t kindergartenNum)
+{
+    this->kindergartenNums[row] = static_cast<uint32_t>(kindergartenNum);
+}
+
+void UnitColumns::reserve(size_t rowCount)
+{
+    // priemerny nazov ma okolo 16 bajtov, kod najviac 12
+    this->titles.reserve(rowCount, rowCount * 16);
+    this->foldedTitles.reserve(rowCount, rowCount * 16);
+    this->codes.reserve(rowCount, rowCount * 12);
+    this->kindergartenNums.reserve(rowCount);
+    this->sortNumbers.reserve(rowCount);
+    this->types.reserve(rowCount);
+    this->units.reserve(rowCount);
+    this->rows.reserve(rowCount);
+}
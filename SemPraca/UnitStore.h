@@ -0,0 +1,122 @@
+#pragma once
+#include <libds/heap_monitor.h>
+#include <memory>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+#include "Unit.h"
+#include "DerivedAttributes.h"
+#include "Cp1250.h"
+
+// jednotky iba ukazuju do pamate areny, preto sa pri uvolneni nemusi volat ziadny destruktor
+static_assert(std::is_trivially_destructible_v<Unit>, "Unit mus by trivilne zruiten, pam sa uvouje naraz.");
+
+// arena: jednotky a ich retazce sa ukladaju za sebou do velkych blokov, ktore sa uvolnia az spolu s arenou
+// jedna arena nie je bezpecna pre viac vlakien naraz
+class UnitArena
+{
+public:
+    UnitArena() = default;
+    UnitArena(const UnitArena&) = delete;
+    UnitArena& operator=(const UnitArena&) = delete;
+
+    Unit* create(size_t sortNumber, std::string_view code, std::string_view officialTitle, std::string_view mediumTitle, std::string_view shortTitle, std::string_view note, size_t kindergartenNum, std::string_view altTitle);
+
+private:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+    char* allocate(size_t size, size_t alignment);
+    std::string_view copy(std::string_view str);
+    std::string_view copyFolded(std::string_view str);
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks{};
+    char* next{ nullptr };            // prva volna pozicia v poslednom bloku
+    size_t freeSize{ 0 };
+};
+
+// vlastnik vsetkych nacitanych jednotiek; sekvencie, hierarchia aj tabulky drzia iba smerniky do skladu
+// pri paralelnom nacitavani si kazde vlakno vytvori vlastnu arenu
+class UnitStore
+{
+public:
+    UnitStore() { this->arenas.emplace_back(); };
+    UnitStore(const UnitStore&) = delete;
+    UnitStore& operator=(const UnitStore&) = delete;
+
+    UnitArena& getArena() { return this->arenas.front(); };
+    UnitArena& createArena();
+    Unit* create(size_t sortNumber, std::string_view code, std::string_view officialTitle, std::string_view mediumTitle, std::string_view shortTitle, std::string_view note, size_t kindergartenNum, std::string_view altTitle)
+        { return this->getArena().create(sortNumber, code, officialTitle, mediumTitle, shortTitle, note, kindergartenNum, altTitle); };
+
+private:
+    std::mutex mutex{};
+    std::deque<UnitArena> arenas{};     // deque => referencie na uz vytvorene areny ostanu platne
+};
+
+Unit* UnitArena::create(size_t sortNumber, std::string_view code, std::string_view officialTitle, std::string_view mediumTitle, std::string_view shortTitle, std::string_view note, size_t kindergartenNum, std::string_view altTitle)
+{
+    // retazce nasleduju hned za jednotkou => pri prehliadke su data jednotky blizko seba
+    Unit* unit = reinterpret_cast<Unit*>(this->allocate(sizeof(Unit), alignof(Unit)));
+    placement_copy(unit, Unit(sortNumber, this->copy(code), this->copy(officialTitle), this->copy(mediumTitle), this->copy(shortTitle), this->copy(note), kindergartenNum, this->copy(altTitle)));
+    unit->setFoldedTitle(this->copyFolded(unit->getOfficialTitle()));
+    DerivedAttributes::derive(*unit);
+    return unit;
+}
+
+char* UnitArena::allocate(size_t size, size_t alignment)
+{
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(this->next) % alignment) % alignment;
+    if (this->next == nullptr || padding + size > this->freeSize)
+    {
+        // prilis velka poziadavka dostane vlastny blok
+        size_t blockSize = (std::max)(BLOCK_SIZE, size + alignment);
+        this->blocks.emplace_back(new char[blockSize]);
+        this->next = this->blocks.back().get();
+        this->freeSize = blockSize;
+        padding = (alignment - reinterpret_cast<uintptr_t>(this->next) % alignment) % alignment;
+    }
+
+    char* memory = this->next + padding;
+    this->next += padding + size;
+    this->freeSize -= padding + size;
+    return memory;
+}
+
+std::string_view UnitArena::copy(std::string_view str)
+{
+    if (str.empty())
+    {
+        return std::string_view{};
+    }
+
+    char* memory = this->allocate(str.size(), 1);
+    std::memcpy(memory, str.data(), str.size());
+    return std::string_view(memory, str.size());
+}
+
+std::string_view UnitArena::copyFolded(std::string_view str)
+{
+    // zlozeny nazov sa vypocita raz, pri hladani sa uz len porovnava
+    if (str.empty())
+    {
+        return std::string_view{};
+    }
+
+    char* memory = this->allocate(str.size(), 1);
+    for (size_t i = 0; i < str.size(); ++i)
+    {
+        memory[i] = Cp1250::fold(str[i]);
+    }
+    return std::string_view(memory, str.size());
+}
+
+UnitArena& UnitStore::createArena()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->arenas.emplace_back();
+}
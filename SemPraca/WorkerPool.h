@@ -0,0 +1,136 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+// skupina vlakien, ktore cakaju na ulohy; vlakna sa vytvoria raz a pouzivaju sa pri kazdom paralelnom spracovani
+class WorkerPool
+{
+public:
+    WorkerPool(size_t threadCount = std::thread::hardware_concurrency());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t getThreadCount() const { return this->threads.size(); };
+
+    // rozdeli interval [0, count) na chunkCount suvislych usekov a kazdy spracuje ako ulohu: work(chunkIndex, begin, end)
+    // vrati sa az po spracovani vsetkych usekov; prva zachytena vynimka sa prehodi volajucemu
+    void parallelFor(size_t count, size_t chunkCount, const std::function<void(size_t, size_t, size_t)>& work);
+    void parallelFor(size_t count, const std::function<void(size_t, size_t, size_t)>& work) { this->parallelFor(count, this->getThreadCount(), work); };
+
+private:
+    void workerLoop();
+
+private:
+    std::vector<std::thread> threads{};
+    std::deque<std::function<void()>> tasks{};
+    std::mutex mutex{};
+    std::condition_variable taskAvailable{};
+    bool stopping{ false };
+};
+
+WorkerPool::WorkerPool(size_t threadCount)
+{
+    threadCount = threadCount == 0 ? 1 : threadCount;
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        this->threads.emplace_back([this]() { this->workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->taskAvailable.notify_all();
+
+    for (auto& thread : this->threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->taskAvailable.wait(lock, [this]() { return this->stopping || !this->tasks.empty(); });
+            if (this->tasks.empty())
+            {
+                return;
+            }
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void WorkerPool::parallelFor(size_t count, size_t chunkCount, const std::function<void(size_t, size_t, size_t)>& work)
+{
+    chunkCount = chunkCount == 0 ? 1 : chunkCount > count ? count : chunkCount;
+    if (chunkCount <= 1)
+    {
+        if (count > 0)
+        {
+            work(0, 0, count);
+        }
+        return;
+    }
+
+    std::mutex doneMutex;
+    std::condition_variable allDone;
+    size_t remaining = chunkCount;
+    std::exception_ptr error{};
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            size_t begin = count * chunk / chunkCount;
+            size_t end = count * (chunk + 1) / chunkCount;
+            this->tasks.emplace_back([&, chunk, begin, end]()
+                {
+                    std::exception_ptr chunkError{};
+                    try
+                    {
+                        work(chunk, begin, end);
+                    }
+                    catch (...)
+                    {
+                        chunkError = std::current_exception();
+                    }
+
+                    std::lock_guard<std::mutex> doneLock(doneMutex);
+                    if (chunkError && !error)
+                    {
+                        error = chunkError;
+                    }
+                    if (--remaining == 0)
+                    {
+                        allDone.notify_one();
+                    }
+                });
+        }
+    }
+    this->taskAvailable.notify_all();
+
+    std::unique_lock<std::mutex> doneLock(doneMutex);
+    allDone.wait(doneLock, [&remaining]() { return remaining == 0; });
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}